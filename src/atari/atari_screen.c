@@ -0,0 +1,53 @@
+#include <peekpoke.h>
+
+#include "atari_screen.h"
+
+#define SAVMSC 88           /* OS pointer to the text screen's display memory */
+#define SCREEN_ROWS 24
+
+/* Byte offset of each 40-column row, so no multiply per character. */
+static const unsigned int row_offset[SCREEN_ROWS] = {
+      0,  40,  80, 120, 160, 200, 240, 280,
+    320, 360, 400, 440, 480, 520, 560, 600,
+    640, 680, 720, 760, 800, 840, 880, 920
+};
+
+/*
+ * ATASCII to internal screen code: 0x20-0x5F map to 0x00-0x3F,
+ * 0x00-0x1F map to 0x40-0x5F, 0x60-0x7F are unchanged. Bit 7 (inverse
+ * video) passes through.
+ */
+static unsigned char to_screen_code(unsigned char c)
+{
+    unsigned char inverse = c & 0x80;
+
+    c &= 0x7F;
+    if (c < 0x20) {
+        c += 0x40;
+    } else if (c < 0x60) {
+        c -= 0x20;
+    }
+    return c | inverse;
+}
+
+void atari_screen_putc(unsigned char x, unsigned char y, char c)
+{
+    if (y >= SCREEN_ROWS) {
+        return;
+    }
+    POKE(PEEKW(SAVMSC) + row_offset[y] + x, to_screen_code((unsigned char)c));
+}
+
+void atari_screen_puts(unsigned char x, unsigned char y, const char *s)
+{
+    unsigned char *dst;
+
+    if (y >= SCREEN_ROWS) {
+        return;
+    }
+    dst = (unsigned char *)(PEEKW(SAVMSC) + row_offset[y] + x);
+    while (*s && x < 40) {
+        *dst++ = to_screen_code((unsigned char)*s++);
+        x++;
+    }
+}
@@ -0,0 +1,11 @@
+#ifndef KILLZONE_ATARI_SCREEN_H
+#define KILLZONE_ATARI_SCREEN_H
+
+/* Direct screen-memory output for the GRAPHICS 0 text screen. Writes the
+ * internal screen code straight into display memory (located via SAVMSC),
+ * bypassing conio's cursor bookkeeping. The conio cursor is not moved, and
+ * writing the bottom-right cell cannot scroll the screen. */
+void atari_screen_putc(unsigned char x, unsigned char y, char c);
+void atari_screen_puts(unsigned char x, unsigned char y, const char *s);
+
+#endif /* KILLZONE_ATARI_SCREEN_H */
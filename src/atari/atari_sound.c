@@ -46,34 +46,50 @@ static const sound_step_t death_steps[] = {
     { 212, 4, 5 }
 };
 
-static const sound_step_t *active_steps;
-static unsigned char active_step_count;
-static unsigned char active_step_index;
-static unsigned char active_step_frames;
-static unsigned char initialized;
-
-static void start_step(unsigned char index) {
-    const sound_step_t *step = &active_steps[index];
+/* Beethoven - Ode to Joy (first phrase): E E F G G F E D C C D E  E. D D
+ * PAL AUDF values: C4=0x1D D4=0x1A E4=0x17 F4=0x16 G4=0x13. Each note is
+ * followed by a 2-frame silent step for note separation. */
+static const sound_step_t melody_steps[] = {
+    { 0x17, 8, 14 }, { 0x17, 0, 2 }, { 0x17, 8, 14 }, { 0x17, 0, 2 },
+    { 0x16, 8, 14 }, { 0x16, 0, 2 }, { 0x13, 8, 14 }, { 0x13, 0, 2 },
+    { 0x13, 8, 14 }, { 0x13, 0, 2 }, { 0x16, 8, 14 }, { 0x16, 0, 2 },
+    { 0x17, 8, 14 }, { 0x17, 0, 2 }, { 0x1A, 8, 14 }, { 0x1A, 0, 2 },
+    { 0x1D, 8, 14 }, { 0x1D, 0, 2 }, { 0x1D, 8, 14 }, { 0x1D, 0, 2 },
+    { 0x1A, 8, 14 }, { 0x1A, 0, 2 }, { 0x17, 8, 14 }, { 0x17, 0, 2 },
+    { 0x17, 8, 22 }, { 0x17, 0, 2 }, { 0x1A, 8,  6 }, { 0x1A, 0, 2 },
+    { 0x1A, 8, 30 }, { 0x1A, 0, 2 }
+};
 
-    /* The game polls the server constantly over FujiNet/NetSIO. SIO
-     * transactions can leave SKCTL outside its normal run state, and
-     * with bits 0-1 both clear POKEY's 64KHz audio clock freezes
-     * entirely - so reassert it immediately before every note. */
-    POKE(SKCTL, 0x03);
+/* Command queue consumed by the immediate VBI sequencer (atari_sound_vbi.s).
+ * The main loop only writes the tail entry and then publishes it by
+ * advancing sound_queue_tail; the VBI only advances sound_queue_head.
+ * Stopping bypasses the queue through sound_stop, which the VBI checks
+ * first and clears, so a full queue cannot swallow it. */
+#define SOUND_QUEUE_SIZE 4
+#define SOUND_QUEUE_MASK (SOUND_QUEUE_SIZE - 1)
+unsigned char sound_queue_lo[SOUND_QUEUE_SIZE];
+unsigned char sound_queue_hi[SOUND_QUEUE_SIZE];
+unsigned char sound_queue_len[SOUND_QUEUE_SIZE];
+volatile unsigned char sound_queue_head;
+volatile unsigned char sound_queue_tail;
+volatile unsigned char sound_stop;
+
+void atari_sound_vbi_install(void);
+void atari_sound_vbi_remove(void);
 
-    POKE(AUDF1, step->freq);
-    POKE(AUDC1, AUDC_PURE_TONE | step->vol);
-    active_step_index = index;
-    active_step_frames = step->frames;
-}
+static unsigned char initialized;
 
 static void play_sequence(const sound_step_t *steps, unsigned char count) {
-    if (!initialized) {
-        return;
+    unsigned char tail = sound_queue_tail;
+    unsigned char next = (unsigned char)((tail + 1) & SOUND_QUEUE_MASK);
+
+    if (!initialized || next == sound_queue_head) {
+        return; /* Queue full: drop rather than block */
     }
-    active_steps = steps;
-    active_step_count = count;
-    start_step(0);
+    sound_queue_lo[tail] = (unsigned char)((unsigned int)steps & 0xFF);
+    sound_queue_hi[tail] = (unsigned char)((unsigned int)steps >> 8);
+    sound_queue_len[tail] = count;
+    sound_queue_tail = next;
 }
 
 void atari_sound_init(void) {
@@ -86,10 +102,10 @@ void atari_sound_init(void) {
     POKE(AUDC1, 0);
     POKE(AUDC2, 0);
 
-    active_steps = 0;
-    active_step_count = 0;
-    active_step_index = 0;
-    active_step_frames = 0;
+    sound_queue_head = 0;
+    sound_queue_tail = 0;
+    sound_stop = 0;
+    atari_sound_vbi_install();
 
     initialized = 1;
 }
@@ -99,112 +115,21 @@ void atari_sound_shutdown(void) {
         return;
     }
 
+    atari_sound_vbi_remove();
     POKE(AUDC1, 0);
     POKE(AUDC2, 0);
 
     initialized = 0;
 }
 
-void atari_sound_tick(void) {
-    if (!initialized) {
-        return;
-    }
-
-    /* The OS continuously reasserts POKEY channel state while NetSIO is
-     * clocking transfers (same mechanism that was clobbering our own
-     * channel 1 volume mid-note). Mask channels 3 & 4's volume nibble
-     * every tick to silence that audible clock without ever writing
-     * their frequency or distortion bits, which NetSIO still owns. */
-    POKE(AUDC3, PEEK(AUDC3) & 0xF0);
-    POKE(AUDC4, PEEK(AUDC4) & 0xF0);
-
-    if (active_step_count == 0) {
-        return;
-    }
-
-    /* Reassert our own note every tick too, for the same reason - one
-     * write at note-start isn't enough to survive the OS clobbering it
-     * mid-note. */
-    POKE(AUDC1, AUDC_PURE_TONE | active_steps[active_step_index].vol);
-
-    if (active_step_frames > 0) {
-        active_step_frames--;
-        if (active_step_frames == 0) {
-            unsigned char next = (unsigned char)(active_step_index + 1);
-            if (next < active_step_count) {
-                start_step(next);
-            } else {
-                POKE(AUDC1, 0);
-                active_step_count = 0;
-            }
-        }
-    }
-}
-
-/* RTCLOK low byte ($14) - incremented by the OS every vertical blank.
- * Used for blocking note timing on the splash screen, where the main
- * frame-tick sequencer is not running (input_wait_key blocks the loop). */
-#define RTCLOK2 ((unsigned int)20U)
-
-typedef struct {
-    unsigned char freq;   /* PAL 8-bit AUDF divider value */
-    unsigned char frames; /* note duration in VBI frames */
-} melody_note_t;
-
-/* Beethoven - Ode to Joy (first phrase): E E F G G F E D C C D E  E. D D
- * PAL AUDF values: C4=0x1D D4=0x1A E4=0x17 F4=0x16 G4=0x13 */
-static const melody_note_t ode_to_joy[] = {
-    { 0x17, 16 }, { 0x17, 16 }, { 0x16, 16 }, { 0x13, 16 },
-    { 0x13, 16 }, { 0x16, 16 }, { 0x17, 16 }, { 0x1A, 16 },
-    { 0x1D, 16 }, { 0x1D, 16 }, { 0x1A, 16 }, { 0x17, 16 },
-    { 0x17, 24 }, { 0x1A,  8 }, { 0x1A, 32 }
-};
-
 void atari_sound_play_melody(void) {
-    unsigned char i;
-    unsigned char f;
-    unsigned char tone_frames;
-    unsigned char last;
-    unsigned char count = (unsigned char)(sizeof(ode_to_joy) / sizeof(ode_to_joy[0]));
-
-    if (!initialized) {
-        return;
-    }
+    play_sequence(melody_steps, sizeof(melody_steps) / sizeof(melody_steps[0]));
+}
 
-    POKE(SKCTL, 0x03);   /* ensure POKEY audio clock is running */
-    POKE(AUDCTL, 0);     /* plain 8-bit tone mode, 64KHz base clock */
-
-    for (i = 0; i < count; i++) {
-        /* Last 2 frames of each note are silent, for note separation. */
-        tone_frames = ode_to_joy[i].frames;
-        if (tone_frames > 2) {
-            tone_frames = (unsigned char)(tone_frames - 2);
-        } else {
-            tone_frames = 0;
-        }
-
-        for (f = 0; f < ode_to_joy[i].frames; f++) {
-            /* Re-assert the note EVERY frame. SIO/OS activity clobbers the
-             * channel-1 volume nibble between frames; the working sound
-             * effects survive by re-poking every tick, so the melody must
-             * do the same or its notes fall silent. */
-            POKE(AUDF1, ode_to_joy[i].freq);
-            if (f < tone_frames) {
-                POKE(AUDC1, AUDC_PURE_TONE | 8);   /* pure tone, volume 8 */
-            } else {
-                POKE(AUDC1, 0);                    /* gap between notes */
-            }
-
-            /* Wait one video frame via the OS frame counter (verified to
-             * increment ~1 per frame in this environment). */
-            last = PEEK(RTCLOK2);
-            while (PEEK(RTCLOK2) == last) {
-                /* spin until the next vertical-blank tick */
-            }
-        }
+void atari_sound_stop(void) {
+    if (initialized) {
+        sound_stop = 1;
     }
-
-    POKE(AUDC1, 0);      /* silence when done */
 }
 
 void atari_sound_play_hit(void) {
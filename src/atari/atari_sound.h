@@ -12,13 +12,14 @@
 void atari_sound_init(void);
 void atari_sound_shutdown(void);
 
-/* Call once per game loop iteration to advance any playing effect. */
-void atari_sound_tick(void);
-
+/* Effects are queued and played by an immediate VBI handler, so these
+ * return immediately and timing does not depend on the main loop, even
+ * during SIO. A new effect replaces the one playing; stop always wins. */
 void atari_sound_play_hit(void);
 void atari_sound_play_kill(void);
 void atari_sound_play_join(void);
 void atari_sound_play_death(void);
 void atari_sound_play_melody(void);
+void atari_sound_stop(void);
 
 #endif
@@ -0,0 +1,143 @@
+; KillZone Atari Sound - immediate VBI step sequencer
+;
+; Plays the step sequences queued by atari_sound.c once per vertical
+; blank, so effect timing is hardware time no matter how long the main
+; loop stalls in SIO or a redraw. The main loop only appends commands to
+; a 4-entry ring (pointer + step count); this handler consumes them.
+; It hangs off the immediate vector because the OS skips deferred VBIs
+; while CRITIC is set, i.e. for the whole of every SIO transfer.
+; Runs in interrupt context: touches only its own zero page pointer.
+
+        .export _atari_sound_vbi_install, _atari_sound_vbi_remove
+        .import _sound_queue_lo, _sound_queue_hi, _sound_queue_len
+        .import _sound_queue_head, _sound_queue_tail, _sound_stop
+
+CRITIC  = $42           ; Non-zero while SIO is running
+VVBLKI  = $0222         ; Immediate VBI vector
+SETVBV  = $E45C         ; OS routine to set a VBI vector safely
+
+AUDF1   = $D200
+AUDC1   = $D201
+AUDC3   = $D205
+AUDC4   = $D207
+SKCTL   = $D20F
+
+AUDC_PURE_TONE  = $A0   ; Pure-tone distortion bits (see atari_sound.c)
+QUEUE_MASK      = 3     ; Ring of 4 commands
+STEP_SIZE       = 3     ; sound_step_t: freq, vol, frames
+
+        .zeropage
+seq_ptr:        .res 2  ; Active sequence
+
+        .bss
+seq_left:       .res 1  ; Steps left including the current one (0 = idle)
+seq_offset:     .res 1  ; Byte offset of the current step
+seq_frames:     .res 1  ; Frames left in the current step
+old_vvblki:     .res 2  ; Handler we chain to (normally SYSVBV)
+
+        .code
+
+; void atari_sound_vbi_install(void)
+_atari_sound_vbi_install:
+        lda     #0
+        sta     seq_left
+        lda     VVBLKI
+        sta     old_vvblki
+        lda     VVBLKI+1
+        sta     old_vvblki+1
+        ldy     #<sound_vbi
+        ldx     #>sound_vbi
+        lda     #6              ; 6 = immediate VBI
+        jmp     SETVBV
+
+; void atari_sound_vbi_remove(void)
+_atari_sound_vbi_remove:
+        ldy     old_vvblki
+        ldx     old_vvblki+1
+        lda     #6
+        jmp     SETVBV
+
+; Start the step at byte offset Y: reassert the POKEY clock, set the note
+start_step:
+        sty     seq_offset
+        lda     CRITIC          ; Mid-transfer SKCTL belongs to SIO
+        bne     @note
+        lda     #$03            ; SIO can leave SKCTL with the audio clock stopped
+        sta     SKCTL
+@note:
+        lda     (seq_ptr),y
+        sta     AUDF1
+        iny
+        iny
+        lda     (seq_ptr),y
+        sta     seq_frames
+        rts
+
+sound_vbi:
+        ; NetSIO clocks transfers on channels 3 & 4; silence their volume
+        ; nibble without touching the frequency/distortion bits it owns
+        lda     AUDC3
+        and     #$F0
+        sta     AUDC3
+        lda     AUDC4
+        and     #$F0
+        sta     AUDC4
+
+        ; A stop skips the ring so it can never be dropped; whatever was
+        ; queued before it goes too
+        lda     _sound_stop
+        beq     @queue
+        lda     #0
+        sta     _sound_stop
+        sta     seq_left
+        lda     _sound_queue_tail
+        sta     _sound_queue_head
+        jmp     @silence
+
+@queue:
+        ; A queued command replaces whatever is playing
+        lda     _sound_queue_head
+        cmp     _sound_queue_tail
+        beq     @tick
+        tax
+        lda     _sound_queue_lo,x
+        sta     seq_ptr
+        lda     _sound_queue_hi,x
+        sta     seq_ptr+1
+        lda     _sound_queue_len,x
+        sta     seq_left
+        inx
+        txa
+        and     #QUEUE_MASK
+        sta     _sound_queue_head
+        ldy     #0
+        jsr     start_step
+
+@tick:
+        lda     seq_left
+        beq     @done
+
+        ; The OS clobbers channel 1 volume mid-note; reassert every frame
+        ldy     seq_offset
+        iny
+        lda     (seq_ptr),y
+        ora     #AUDC_PURE_TONE
+        sta     AUDC1
+
+        dec     seq_frames
+        bne     @done
+        dec     seq_left
+        beq     @silence
+        lda     seq_offset
+        clc
+        adc     #STEP_SIZE
+        tay
+        jsr     start_step
+        jmp     @done
+
+@silence:
+        lda     #0
+        sta     AUDC1
+
+@done:
+        jmp     (old_vvblki)
@@ -0,0 +1,128 @@
+/**
+ * KillZone Clock Module Implementation
+ */
+
+#include "clock.h"
+#ifdef __ATARI__
+#include <peekpoke.h>
+#elif !defined(_CMOC_VERSION_)
+#include <time.h>
+#endif
+
+#ifdef __ATARI__
+#define RTCLOK_MID 19       /* OS frame counter, middle byte */
+#define RTCLOK_LO 20        /* OS frame counter, low byte (every VBI) */
+#define GTIA_PAL 0xD014     /* Bits 1-3 clear on PAL machines */
+#elif defined(_CMOC_VERSION_)
+#define COCO_TIMER ((volatile uint16_t *)0x0112)  /* Color BASIC 60Hz TIMER */
+#else
+/* No frame counter to read: one jiffy per main-loop pass instead */
+#define SOFT_JIFFIES 1
+static uint16_t soft_jiffies = 0;
+#endif
+
+static uint8_t clock_hz = 60;
+
+/**
+ * Initialize clock
+ */
+void kz_clock_init(void) {
+#ifdef __ATARI__
+    clock_hz = (PEEK(GTIA_PAL) & 0x0E) ? 60 : 50;
+#else
+    clock_hz = 60;
+#endif
+}
+
+/**
+ * Read the jiffy counter
+ */
+uint16_t kz_clock_jiffies(void) {
+#ifdef __ATARI__
+    uint8_t lo;
+    uint8_t mid;
+
+    /* The VBI can carry into the middle byte between our two reads */
+    do {
+        lo = PEEK(RTCLOK_LO);
+        mid = PEEK(RTCLOK_MID);
+    } while (lo != PEEK(RTCLOK_LO));
+    return ((uint16_t)mid << 8) | lo;
+#elif defined(_CMOC_VERSION_)
+    return *COCO_TIMER;
+#else
+    return soft_jiffies;
+#endif
+}
+
+/**
+ * Convert milliseconds to jiffies
+ */
+uint16_t kz_clock_ms(uint16_t ms) {
+    uint16_t jiffies = (uint16_t)(((unsigned long)ms * clock_hz) / 1000UL);
+
+    return jiffies > 0 ? jiffies : 1;
+}
+
+/**
+ * Idle until the next jiffy
+ */
+void kz_clock_wait_frame(void) {
+#ifdef SOFT_JIFFIES
+    soft_jiffies++;
+#else
+    uint16_t start = kz_clock_jiffies();
+
+    while (kz_clock_jiffies() == start) {
+        /* idle until the next vertical blank */
+    }
+#endif
+}
+
+/**
+ * Idle for a number of milliseconds
+ */
+void kz_clock_pause(uint16_t ms) {
+#ifdef SOFT_JIFFIES
+    clock_t start = clock();
+    clock_t target = (clock_t)(((unsigned long)ms * CLOCKS_PER_SEC) / 1000UL);
+
+    while ((clock() - start) < target) {
+        /* busy wait */
+    }
+#else
+    uint16_t start = kz_clock_jiffies();
+    uint16_t wait = kz_clock_ms(ms);
+
+    while ((uint16_t)(kz_clock_jiffies() - start) < wait) {
+        /* idle */
+    }
+#endif
+}
+
+/**
+ * Start a periodic task; the first run is one interval from now
+ */
+void kz_task_start(kz_task_t *task, uint16_t interval_ms) {
+    task->interval = kz_clock_ms(interval_ms);
+    task->last = kz_clock_jiffies();
+}
+
+/**
+ * Check whether a task is due, rearming it if so. A task that fell
+ * several intervals behind runs once, not once per missed interval.
+ */
+uint8_t kz_task_due(kz_task_t *task) {
+    uint16_t now = kz_clock_jiffies();
+    uint16_t elapsed = (uint16_t)(now - task->last);
+
+    if (elapsed < task->interval) {
+        return 0;
+    }
+    if (elapsed >= (uint16_t)(task->interval * 2)) {
+        task->last = now;
+    } else {
+        task->last += task->interval;
+    }
+    return 1;
+}
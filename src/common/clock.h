@@ -0,0 +1,44 @@
+/**
+ * KillZone Clock Module
+ *
+ * Jiffy clock and fixed-interval task scheduler. Jiffies come from the
+ * frame counter the OS already advances every vertical blank (RTCLOK on
+ * Atari, the Color BASIC TIMER on CoCo), so task cadence is real time
+ * and identical across platforms rather than tied to CPU speed.
+ */
+
+#ifndef KILLZONE_CLOCK_H
+#define KILLZONE_CLOCK_H
+
+#ifdef _CMOC_VERSION_
+#include <cmoc.h>
+#else
+#include <stdint.h>
+#endif
+
+/* Periodic task */
+typedef struct {
+    uint16_t last;      /* Jiffy count the task last ran at */
+    uint16_t interval;  /* Jiffies between runs */
+} kz_task_t;
+
+/* Initialization (detects the 50/60Hz frame rate where possible) */
+void kz_clock_init(void);
+
+/* Jiffies since power-on; wraps at 16 bits */
+uint16_t kz_clock_jiffies(void);
+
+/* Convert milliseconds to jiffies (at least 1) */
+uint16_t kz_clock_ms(uint16_t ms);
+
+/* Idle until the next jiffy - paces the main loop to the frame rate */
+void kz_clock_wait_frame(void);
+
+/* Idle for the given number of milliseconds */
+void kz_clock_pause(uint16_t ms);
+
+/* Scheduler: start a task, then poll kz_task_due() once per loop */
+void kz_task_start(kz_task_t *task, uint16_t interval_ms);
+uint8_t kz_task_due(kz_task_t *task);
+
+#endif /* KILLZONE_CLOCK_H */
@@ -17,6 +17,17 @@
 #define STATUS_BAR_HEIGHT 4
 #define STATUS_BAR_START (DISPLAY_HEIGHT)
 
+/* Play field declared to the server at join; it only sends entities
+ * inside this rectangle around the player */
+#define VIEW_WIDTH DISPLAY_WIDTH
+#define VIEW_HEIGHT DISPLAY_HEIGHT
+
+/* Zone requested at join; a clustered server routes the connection to
+ * the process hosting it (a single server ignores it) */
+#ifndef SERVER_ZONE
+#define SERVER_ZONE 0
+#endif
+
 /* Display Characters */
 #define CHAR_EMPTY '.'
 #define CHAR_PLAYER '@'
@@ -25,7 +36,7 @@
 #define CHAR_WALL '#'
 
 /* Player Limits */
-#define MAX_OTHER_PLAYERS 10
+#define MAX_OTHER_PLAYERS 64  /* Remote entities tracked (6 bytes each, max 127) */
 #define PLAYER_NAME_MAX 32
 
 /* Server Configuration */
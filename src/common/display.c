@@ -10,6 +10,7 @@
 #ifdef __ATARI__
 #include "atari_visuals.h"
 #include "atari_sound.h"
+#include "atari_screen.h"
 #endif
 #ifdef _CMOC_VERSION_
 #include <cmoc.h>
@@ -38,13 +39,26 @@
 #define USE_GAME_FONT() ((void)0)
 #endif
 
+/*
+ * Fixed-position output for the play field and status bar. The Atari
+ * writes screen codes straight into display memory; other targets go
+ * through conio.
+ */
+#ifdef __ATARI__
+#define SCREEN_PUTC(x, y, c) atari_screen_putc((x), (y), (c))
+#define SCREEN_PUTS(x, y, s) atari_screen_puts((x), (y), (s))
+#else
+#define SCREEN_PUTC(x, y, c) cputcxy((x), (y), (c))
+#define SCREEN_PUTS(x, y, s) cputsxy((x), (y), (s))
+#endif
+
 static uint8_t status_needs_redraw = 1;
 
 static void display_clear_line(uint8_t y, uint8_t width) {
     uint8_t x;
 
     for (x = 0; x < width; x++) {
-        cputcxy(x, y, ' ');
+        SCREEN_PUTC(x, y, ' ');
     }
 }
 
@@ -56,7 +70,7 @@ static void display_puts_limited(uint8_t x, uint8_t y, const char *text, uint8_t
     }
 
     for (i = 0; i < max_len && text[i] != '\0'; i++) {
-        cputcxy((uint8_t)(x + i), y, text[i]);
+        SCREEN_PUTC((uint8_t)(x + i), y, text[i]);
     }
 }
 
@@ -259,7 +273,7 @@ void display_show_connect_status(const char *host, uint16_t port, uint8_t attemp
  * Draw status bar (last 4 lines of screen)
  * 
  * Shows: player name, player count, connection status, world ticks
- * Uses cputsxy for direct character placement without scrolling
+ * Uses fixed-position writes (SCREEN_PUTC) so it never scrolls
  */
 void display_draw_status_bar(const char *player_name, uint8_t player_count, 
                              const char *connection_status, uint16_t world_ticks) {
@@ -285,7 +299,7 @@ void display_draw_status_bar(const char *player_name, uint8_t player_count,
     snprintf(line_buf, sizeof(line_buf), "%s P:%d %s", player_name, player_count, connection_status);
     if (status_needs_redraw || strcmp(line_buf, last_info_buf) != 0) {
         for (x = 0; x < 30; x++) {
-            cputcxy(x, 20, ' ');
+            SCREEN_PUTC(x, 20, ' ');
         }
         display_puts_limited(0, 20, line_buf, 29);
         strncpy(last_info_buf, line_buf, sizeof(last_info_buf) - 1);
@@ -295,7 +309,7 @@ void display_draw_status_bar(const char *player_name, uint8_t player_count,
     snprintf(ticks_buf, sizeof(ticks_buf), "T:%d", world_ticks);
     if (status_needs_redraw || strcmp(ticks_buf, last_ticks_buf) != 0) {
         for (x = 30; x < 39; x++) {
-            cputcxy(x, 20, ' ');
+            SCREEN_PUTC(x, 20, ' ');
         }
         display_puts_limited(30, 20, ticks_buf, 9);
         strncpy(last_ticks_buf, ticks_buf, sizeof(last_ticks_buf) - 1);
@@ -305,7 +319,7 @@ void display_draw_status_bar(const char *player_name, uint8_t player_count,
     if (status_needs_redraw || !static_status_drawn) {
         /* Line 21: reserved for combat messages. */
         for (x = 0; x < 39; x++) {
-            cputcxy(x, 21, ' ');
+            SCREEN_PUTC(x, 21, ' ');
         }
 
         /* Line 22: Separator */
@@ -316,7 +330,7 @@ void display_draw_status_bar(const char *player_name, uint8_t player_count,
          * advance the Atari text cursor and scroll the display.
          */
         for (x = 0; x < 39; x++) {
-            cputcxy(x, 23, ' ');
+            SCREEN_PUTC(x, 23, ' ');
         }
         display_puts_limited(0, 23, "WASD=Move R=Refresh Q=Quit", 27);
         static_status_drawn = 1;
@@ -331,7 +345,7 @@ void display_draw_status_bar(const char *player_name, uint8_t player_count,
             ver_len = 38;
         }
         for (x = 27; x < 39; x++) {
-            cputcxy(x, 23, ' ');
+            SCREEN_PUTC(x, 23, ' ');
         }
         display_puts_limited((uint8_t)(39 - ver_len), 23, ver_buf, ver_len);
         strncpy(last_ver_buf, ver_buf, sizeof(last_ver_buf) - 1);
@@ -368,163 +382,145 @@ void display_draw_combat_message(const char *message) {
 }
 
 /* Game Rendering */
-void display_render_game(const player_state_t *local, const player_state_t *others, uint8_t count, int force_refresh) {
-    static uint8_t last_player_x = 255;
-    static uint8_t last_player_y = 255;
-    static uint8_t last_other_positions[MAX_OTHER_PLAYERS * 2];  /* x,y pairs */
-    static uint8_t last_other_count = 255;
-    static int world_rendered = 0; /* Moved declaration to top */
-    static int positions_initialized = 0;
-    uint8_t y, i;
-    uint8_t x;
-    char entity_char;
 
-    /* The world map uses the custom tile font (grass/players/monsters). */
-    USE_GAME_FONT();
+/* Map character per entity_kind_t */
+static const char entity_chars[] = { CHAR_WALL, CHAR_ENEMY, CHAR_HUNTER };
+
+/*
+ * Play-field shadow buffer. field_shown mirrors what is on screen and
+ * field_want what should be; a set bit in field_dirty means the cell's
+ * wanted tile may have changed. Flushing visits only dirty cells and
+ * writes only those that differ, so each frame costs at most one screen
+ * write per cell that actually changed, regardless of entity order.
+ */
+#define FIELD_CELLS (DISPLAY_WIDTH * DISPLAY_HEIGHT)
+static char field_shown[FIELD_CELLS];
+static char field_want[FIELD_CELLS];
+static uint8_t field_dirty[FIELD_CELLS / 8];
+static uint16_t field_occupied[MAX_OTHER_PLAYERS + 1]; /* Non-empty cells last frame */
+static uint8_t field_occupied_count = 0;
+
+/*
+ * Scrolling viewport: the world cell shown at the play field's top-left.
+ * It follows the local player, centred and clamped to the world edges the
+ * same way the server clamps the viewport it filters our entities by.
+ * The empty field is uniform, so a scroll costs only the entity cells the
+ * shadow buffer sees change.
+ */
+static uint16_t camera_x = 0;
+static uint16_t camera_y = 0;
+
+static uint16_t camera_origin(uint16_t pos, uint16_t world_size, uint8_t span) {
+    if (world_size <= span || pos < span / 2) {
+        return 0;
+    }
+    pos -= span / 2;
+    if (pos > world_size - span) {
+        return (uint16_t)(world_size - span);
+    }
+    return pos;
+}
+
+static void field_set(uint16_t wx, uint16_t wy, char tile) {
+    uint16_t cell;
+
+    /* World to play-field coordinates; off-screen entities are skipped */
+    if (wx < camera_x || wy < camera_y) {
+        return;
+    }
+    wx -= camera_x;
+    wy -= camera_y;
+    if (wx >= DISPLAY_WIDTH || wy >= DISPLAY_HEIGHT) {
+        return;
+    }
+    cell = wy * DISPLAY_WIDTH + wx;
+    field_want[cell] = tile;
+    field_dirty[cell >> 3] |= (uint8_t)(1 << (cell & 7));
+    field_occupied[field_occupied_count++] = cell;
+}
 
-    /* Initialize position tracking to invalid values on first call */
-    if (!positions_initialized) {
-        for (i = 0; i < MAX_OTHER_PLAYERS * 2; i++) {
-            last_other_positions[i] = 255;
+static void field_flush(void) {
+    uint8_t i;
+    uint8_t bit;
+    uint8_t bits;
+    uint16_t cell;
+
+    for (i = 0; i < sizeof(field_dirty); i++) {
+        bits = field_dirty[i];
+        if (!bits) {
+            continue;
+        }
+        field_dirty[i] = 0;
+        for (bit = 0; bit < 8; bit++) {
+            if (!(bits & (1 << bit))) {
+                continue;
+            }
+            cell = ((uint16_t)i << 3) | bit;
+            if (field_want[cell] != field_shown[cell]) {
+                field_shown[cell] = field_want[cell];
+                SCREEN_PUTC((uint8_t)(cell % DISPLAY_WIDTH), (uint8_t)(cell / DISPLAY_WIDTH), field_want[cell]);
+            }
         }
-        positions_initialized = 1;
     }
+}
+
+void display_render_game(const player_state_t *local, const entity_t *others, uint8_t count, int force_refresh) {
+    static int world_rendered = 0;
+    static char empty_row[DISPLAY_WIDTH + 1];
+    uint8_t y, i;
+    uint16_t cell;
+
+    /* The world map uses the custom tile font (grass/players/monsters). */
+    USE_GAME_FONT();
     
-    if (!local || local->x >= 255 || local->y >= 255) {
+    if (!local || local->x >= state_get_world_width() || local->y >= state_get_world_height()) {
         return;
     }
 
-    /* Full redraw on first render or when player count changes or refresh requested */
-    
     if (force_refresh) {
         world_rendered = 0;
     }
     
-    /* Only do full redraw on first render or explicit refresh */
+    /* Full redraw on first render or explicit refresh: repaint the empty
+     * field a row at a time, then let the shadow redraw the entities */
     if (!world_rendered) {
         clrscr();
         status_needs_redraw = 1;
-        /* Draw world line by line - this fills the play area */
-#ifdef __APPLE2__
-        {
-            static const char empty_row[] = "........................................";
-            for (y = 0; y < DISPLAY_HEIGHT; y++) {
-                cputsxy(0, y, empty_row);
-            }
-        }
-#else
+        memset(empty_row, CHAR_EMPTY, DISPLAY_WIDTH);
+        empty_row[DISPLAY_WIDTH] = '\0';
         for (y = 0; y < DISPLAY_HEIGHT; y++) {
-            for (x = 0; x < DISPLAY_WIDTH; x++) {
-                cputcxy(x, y, CHAR_EMPTY);
-            }
-        }
-#endif
-        
-        /* Draw other entities */
-        for (i = 0; i < count; i++) {
-            if (others[i].x < DISPLAY_WIDTH && others[i].y < DISPLAY_HEIGHT) {
-                if (strcmp(others[i].type, "player") == 0) {
-                    entity_char = CHAR_WALL;
-                } else if (others[i].isHunter) {
-                    entity_char = CHAR_HUNTER;
-                } else {
-                    entity_char = CHAR_ENEMY;
-                }
-                cputcxy(others[i].x, others[i].y, entity_char);
-            }
-        }
-        
-        /* Draw local player */
-        if (local->x < DISPLAY_WIDTH && local->y < DISPLAY_HEIGHT) {
-            cputcxy(local->x, local->y, CHAR_PLAYER);
+            SCREEN_PUTS(0, y, empty_row);
         }
-        
-        last_player_x = local->x;
-        last_player_y = local->y;
-        last_other_count = count;
+        memset(field_shown, CHAR_EMPTY, sizeof(field_shown));
+        memset(field_want, CHAR_EMPTY, sizeof(field_want));
+        memset(field_dirty, 0, sizeof(field_dirty));
+        field_occupied_count = 0;
         world_rendered = 1;
-        
-        /* Initialize tracked positions */
-        for (i = 0; i < count && i < MAX_OTHER_PLAYERS; i++) {
-            if (others[i].x < DISPLAY_WIDTH && others[i].y < DISPLAY_HEIGHT) {
-                last_other_positions[i * 2] = others[i].x;
-                last_other_positions[i * 2 + 1] = others[i].y;
-            } else {
-                last_other_positions[i * 2] = 255;
-                last_other_positions[i * 2 + 1] = 255;
-            }
-        }
-        /* Mark remaining slots as invalid */
-        for (i = count; i < MAX_OTHER_PLAYERS; i++) {
-            last_other_positions[i * 2] = 255;
-            last_other_positions[i * 2 + 1] = 255;
-        }
-        
-    } else {
-        /* INCREMENTAL UPDATE - no full redraw */
-        
-        /* If entity count decreased, erase old positions for removed entities */
-        if (count < last_other_count) {
-            for (i = count; i < last_other_count && i < MAX_OTHER_PLAYERS; i++) {
-                uint8_t old_x = last_other_positions[i * 2];
-                uint8_t old_y = last_other_positions[i * 2 + 1];
-                if (old_x < DISPLAY_WIDTH && old_y < DISPLAY_HEIGHT) {
-                    cputcxy(old_x, old_y, CHAR_EMPTY);
-                }
-                last_other_positions[i * 2] = 255;
-                last_other_positions[i * 2 + 1] = 255;
-            }
-        }
-        last_other_count = count;
-        
-        /* Update player position if changed */
-        if (local->x != last_player_x || local->y != last_player_y) {
-            /* Erase old player position */
-            if (last_player_x < DISPLAY_WIDTH && last_player_y < DISPLAY_HEIGHT) {
-                cputcxy(last_player_x, last_player_y, CHAR_EMPTY);
-            }
+    }
 
-            /* Draw new player position */
-            if (local->x < DISPLAY_WIDTH && local->y < DISPLAY_HEIGHT) {
-                cputcxy(local->x, local->y, CHAR_PLAYER);
-            }
-            
-            last_player_x = local->x;
-            last_player_y = local->y;
-        }
-        
-        /* Update other entities incrementally */
-        for (i = 0; i < count && i < MAX_OTHER_PLAYERS; i++) {
-            uint8_t old_x = last_other_positions[i * 2];
-            uint8_t old_y = last_other_positions[i * 2 + 1];
-            uint8_t new_x_other = others[i].x;
-            uint8_t new_y_other = others[i].y;
-            
-            /* If position changed, update it */
-            if (old_x != new_x_other || old_y != new_y_other) {
-                /* Erase old position (if valid) */
-                if (old_x < DISPLAY_WIDTH && old_y < DISPLAY_HEIGHT) {
-                    cputcxy(old_x, old_y, CHAR_EMPTY);
-                }
-                
-                /* Draw new position */
-                if (new_x_other < DISPLAY_WIDTH && new_y_other < DISPLAY_HEIGHT) {
-                    if (strcmp(others[i].type, "player") == 0) {
-                        entity_char = CHAR_WALL;
-                    } else if (others[i].isHunter) {
-                        entity_char = CHAR_HUNTER;
-                    } else {
-                        entity_char = CHAR_ENEMY;
-                    }
-                    cputcxy(new_x_other, new_y_other, entity_char);
-                }
-                
-                /* Update tracked position */
-                last_other_positions[i * 2] = new_x_other;
-                last_other_positions[i * 2 + 1] = new_y_other;
-            }
-        }
+    camera_x = camera_origin(local->x, state_get_world_width(), DISPLAY_WIDTH);
+    camera_y = camera_origin(local->y, state_get_world_height(), DISPLAY_HEIGHT);
+
+    /* Clear last frame's entities in the shadow; cells re-occupied below
+     * end up unchanged and are never written */
+    for (i = 0; i < field_occupied_count; i++) {
+        cell = field_occupied[i];
+        field_want[cell] = CHAR_EMPTY;
+        field_dirty[cell >> 3] |= (uint8_t)(1 << (cell & 7));
     }
+    field_occupied_count = 0;
+
+    if (count > MAX_OTHER_PLAYERS) {
+        count = MAX_OTHER_PLAYERS;
+    }
+    for (i = 0; i < count; i++) {
+        field_set(others[i].x, others[i].y, entity_chars[others[i].kind]);
+    }
+
+    /* Local player last so it wins a shared cell */
+    field_set(local->x, local->y, CHAR_PLAYER);
+
+    field_flush();
 
 #ifdef _CMOC_VERSION_
     gotoxy(DISPLAY_WIDTH -1 , 23); /* Move cursor out of the way */
@@ -36,7 +36,7 @@ void display_draw_command_help(void);
 void display_draw_combat_message(const char *message);
 
 /* Game Rendering */
-void display_render_game(const player_state_t *local, const player_state_t *others, uint8_t count, int force_refresh);
+void display_render_game(const player_state_t *local, const entity_t *others, uint8_t count, int force_refresh);
 
 /* Dialogs and Prompts */
 void display_show_join_prompt(void);
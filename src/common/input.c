@@ -29,21 +29,15 @@ void input_init(void) {
     /* Nothing to initialize for standard conio input yet */
 }
 
-/**
- * Check for input and return command
- * Non-blocking
- */
-input_cmd_t input_check(void) {
-    int c;
-    
-#ifndef _CMOC_VERSION_    
-    if (!kbhit()) {
-        return CMD_NONE;
-    }
-#endif
-    
-    c = normalize_key(cgetc());
-    
+/* Keys read since the last command was taken, oldest first. Filled every
+ * frame so presses made while a network round trip blocks are kept. */
+static input_cmd_t input_queue[INPUT_QUEUE_SIZE];
+static uint8_t input_head = 0;
+static uint8_t input_tail = 0;
+
+#define INPUT_QUEUE_NEXT(i) ((uint8_t)(((i) + 1) & (INPUT_QUEUE_SIZE - 1)))
+
+static input_cmd_t map_key(int c) {
     switch (c) {
         case 'w':
         case 'W':
@@ -99,6 +93,75 @@ input_cmd_t input_check(void) {
     }
 }
 
+static uint8_t is_move(input_cmd_t cmd) {
+    return cmd == CMD_UP || cmd == CMD_DOWN || cmd == CMD_LEFT || cmd == CMD_RIGHT;
+}
+
+/**
+ * Move every pending key into the queue
+ * Non-blocking; keys arriving while the queue is full are left unread
+ */
+void input_poll(void) {
+    int c;
+    input_cmd_t cmd;
+
+    while (INPUT_QUEUE_NEXT(input_tail) != input_head) {
+#ifdef _CMOC_VERSION_
+        /* inkey() returns 0 when no key is down; cgetc() would block */
+        c = inkey();
+        if (c == 0) {
+            break;
+        }
+#else
+        if (!kbhit()) {
+            break;
+        }
+        c = cgetc();
+#endif
+        cmd = map_key(normalize_key(c));
+        if (cmd != CMD_NONE) {
+            input_queue[input_tail] = cmd;
+            input_tail = INPUT_QUEUE_NEXT(input_tail);
+        }
+    }
+}
+
+/**
+ * Check for input and return command
+ * Non-blocking
+ */
+input_cmd_t input_check(void) {
+    input_cmd_t cmd;
+
+    input_poll();
+    if (input_head == input_tail) {
+        return CMD_NONE;
+    }
+    cmd = input_queue[input_head];
+    input_head = INPUT_QUEUE_NEXT(input_head);
+    return cmd;
+}
+
+/**
+ * Take the run of movement commands at the front of the queue
+ */
+uint8_t input_take_moves(input_cmd_t *moves, uint8_t max) {
+    uint8_t count = 0;
+
+    while (count < max && input_head != input_tail && is_move(input_queue[input_head])) {
+        moves[count++] = input_queue[input_head];
+        input_head = INPUT_QUEUE_NEXT(input_head);
+    }
+    return count;
+}
+
+/**
+ * Discard queued commands
+ */
+void input_flush(void) {
+    input_head = input_tail;
+}
+
 /**
  * Wait for a specific key press (blocking)
  */
@@ -33,12 +33,33 @@ typedef enum {
  */
 void input_init(void);
 
+/* Queued commands; must be a power of two (one slot stays empty) */
+#define INPUT_QUEUE_SIZE 8
+
+/**
+ * Move every pending key into the input queue
+ * Non-blocking; call once per frame
+ */
+void input_poll(void);
+
 /**
  * Check for input and return command
- * Non-blocking
+ * Non-blocking; returns the oldest queued command
  */
 input_cmd_t input_check(void);
 
+/**
+ * Take up to max movement commands from the front of the queue,
+ * stopping at the first non-movement command
+ * Returns the number taken
+ */
+uint8_t input_take_moves(input_cmd_t *moves, uint8_t max);
+
+/**
+ * Discard queued commands (e.g. after a blocking prompt)
+ */
+void input_flush(void);
+
 /**
  * Wait for a specific key press (blocking)
  * Returns the character pressed
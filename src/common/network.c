@@ -19,6 +19,7 @@
 #include "fujinet-network.h"
 #include "json_helpers.h"
 #include "constants.h"
+#include "input.h"
 
 /* Toggle for TCP mode - in production this might be a runtime switch or compile-time */
 /* For this step, let's try to prioritize TCP if available, or just have dedicated functions */
@@ -35,6 +36,30 @@ static char query_buf[64];  /* Buffer for JSON keys/paths */
 static char tcp_device_spec[64];
 static uint8_t tcp_connected = 0;
 
+/* Join (0x08) flags */
+#define JOIN_FLAG_WIDE 0x01           /* Every position is a u16, little-endian */
+#define JOIN_FLAG_ZONE 0x02           /* A [Zone] byte follows the name */
+
+/* Delta world state (0x04) bookkeeping */
+#define DELTA_FLAG_FULL 0x01
+static uint16_t delta_ack_ticks = 0;  /* Server tick of the last applied state */
+static uint8_t delta_need_full = 1;   /* Ask for a full snapshot next poll */
+static uint8_t move_seq = 0;          /* Sequence number of the last move sent */
+
+/* Frames the server pushes while subscribed can arrive ahead of any reply */
+#define MAX_DRAIN_FRAMES 4
+static uint8_t apply_delta_frame(void);
+static uint8_t read_reply_type(uint8_t expected);
+
+/* Every server frame is [LenLow] [LenHigh] [Type] [Payload...], the length
+ * counting Type and Payload. A frame is fetched with one header read and
+ * one body read into rx_buf, then parsed from memory. */
+#define RX_FRAME_SIZE 512
+static uint8_t rx_buf[RX_FRAME_SIZE];
+static uint16_t rx_len = 0;           /* Bytes of the current frame in rx_buf */
+
+#define RX_U16(pos) ((uint16_t)rx_buf[pos] | ((uint16_t)rx_buf[(pos) + 1] << 8))
+
 /* --- TCP Helper Functions --- */
 static void mark_connected(void) {
     tcp_connected = 1;
@@ -127,80 +152,80 @@ static uint8_t kz_network_join_player_tcp(const char *name, player_state_t *play
         }
     }
     
-    /* Packet: 0x01 [NameLen] [Name] */
+    /* Packet: 0x08 [Flags] [ViewW] [ViewH] [NameLen] [Name] [Zone]
+     * Joining with our play field size keeps the server from sending
+     * entities we could not draw (or track) as the world grows; wide
+     * positions let the world be larger than 256 cells */
     len = strlen(name);
-    maxNameLen = sizeof(buf) - 2;
+    maxNameLen = sizeof(buf) - 6;
     if (len <= 0 || (size_t)len > maxNameLen) {
         mark_disconnected();
         return 0;
     }
-    buf[0] = 0x01;
-    buf[1] = (uint8_t)len;
-    memcpy(&buf[2], name, len);
-    
-    if (network_write(tcp_device_spec, buf, 2 + len) != FN_ERR_OK) {
-        mark_disconnected();
-        return 0;
-    }
+    buf[0] = 0x08;
+    buf[1] = JOIN_FLAG_WIDE | JOIN_FLAG_ZONE;
+    buf[2] = VIEW_WIDTH;
+    buf[3] = VIEW_HEIGHT;
+    buf[4] = (uint8_t)len;
+    memcpy(&buf[5], name, len);
+    buf[5 + len] = SERVER_ZONE;
     
-    /* Read Response: 0x01 [IDLen] [ID] [X] [Y] [Health] */
-    /* Read header first */
-    len = network_read(tcp_device_spec, buf, 2); 
-    if (len < 2 || buf[0] != 0x01) {
+    if (network_write(tcp_device_spec, buf, 6 + len) != FN_ERR_OK) {
         mark_disconnected();
         return 0;
     }
     
-    idLen = buf[1];
-    if (idLen <= 0 || idLen >= (int)sizeof(player->id) || idLen >= (int)sizeof(buf)) {
+    /* Response: 0x01 [IDLen] [ID] [X16] [Y16] [Health] [Width16] [Height16]
+     *           [VerLen] [Version] */
+    if (!read_reply_type(0x01)) {
         mark_disconnected();
         return 0;
     }
-    /* Read ID */
-    len = network_read(tcp_device_spec, buf, idLen);
-    if (len != idLen) {
+    idLen = rx_buf[1];
+    if (idLen <= 0 || idLen >= (int)sizeof(player->id) || (uint16_t)(idLen + 11) > rx_len) {
         mark_disconnected();
         return 0;
     }
-    memcpy(player->id, buf, idLen);
+    memcpy(player->id, &rx_buf[2], idLen);
     player->id[idLen] = '\0';
     strncpy(player->name, name, sizeof(player->name) - 1);
     player->name[sizeof(player->name) - 1] = '\0';
     
-    /* Read data: X, Y, Health */
-    len = network_read(tcp_device_spec, buf, 3);
-    if (len != 3) {
-        mark_disconnected();
-        return 0;
-    }
+    player->x = RX_U16(2 + idLen);
+    player->y = RX_U16(4 + idLen);
+    player->health = rx_buf[6 + idLen];
+    state_set_world_dimensions(RX_U16(7 + idLen), RX_U16(9 + idLen));
     
-    player->x = buf[0];
-    player->y = buf[1];
-    player->health = buf[2];
-    
-    /* Read server version: [VerLen] [Version] */
-    len = network_read(tcp_device_spec, buf, 1);
-    if (len == 1 && buf[0] > 0 && buf[0] < 16) {
-        int verLen = buf[0];
-        if (verLen >= (int)sizeof(buf)) {
-            mark_disconnected();
-            return 0;
-        }
-        len = network_read(tcp_device_spec, buf, verLen);
-        if (len == verLen) {
+    /* Server version (optional for backward compatibility) */
+    if ((uint16_t)(idLen + 12) <= rx_len) {
+        uint8_t verLen = rx_buf[11 + idLen];
+        if (verLen > 0 && verLen < 16 && (uint16_t)(idLen + 12 + verLen) <= rx_len) {
+            memcpy(buf, &rx_buf[12 + idLen], verLen);
             buf[verLen] = '\0';
             state_set_server_version((char*)buf);
-        } else {
-            mark_disconnected();
-            return 0;
         }
     }
     
     strcpy(player->status, "alive");
     strcpy(player->type, "player");
     player->isHunter = 0;
+    player->handle = 0;
+
+    /* Entity handles from before a (re)join are meaningless now */
+    delta_need_full = 1;
+    state_clear_other_players();
     
     state_set_local_player(player);
+
+    /* Subscribe: the server pushes a full snapshot now and a delta at the
+     * end of every tick that changes the world; drained by
+     * kz_network_drain_updates() without further requests. */
+    buf[0] = 0x05;
+    buf[1] = 0x01;
+    if (network_write(tcp_device_spec, buf, 2) != FN_ERR_OK) {
+        mark_disconnected();
+        return 0;
+    }
     mark_connected();
     return 1;
 }
@@ -211,17 +236,17 @@ uint8_t kz_network_join_player(const char *name, player_state_t *player) {
 }
 
 /* TCP Move Implementation */
-static uint8_t kz_network_move_player_tcp(const char *player_id, const char *direction, move_result_t *result) {
-    uint8_t buf[64];
-    int len;
+static uint8_t kz_network_move_player_tcp(const char *player_id, const char *dirs, uint8_t count, move_result_t *result) {
+    uint8_t buf[6 + (MAX_MOVE_BATCH + 1) / 2];
+    uint8_t i;
+    uint8_t nibble;
+    uint8_t steps;
+    uint8_t msgLen;
+    uint8_t loserLen;
+    uint16_t pos;
     const player_state_t *local;
-    char dirChar = 'x';
-    if (strcmp(direction, "up") == 0) dirChar = 'u';
-    if (strcmp(direction, "down") == 0) dirChar = 'd';
-    if (strcmp(direction, "left") == 0) dirChar = 'l';
-    if (strcmp(direction, "right") == 0) dirChar = 'r';
     
-    if (!tcp_connected || !result) {
+    if (!tcp_connected || !result || count == 0 || count > MAX_MOVE_BATCH) {
         mark_disconnected();
         return 0;
     }
@@ -231,79 +256,101 @@ static uint8_t kz_network_move_player_tcp(const char *player_id, const char *dir
     result->messages[0][0] = '\0';
     result->loser_id[0] = '\0';
     
-    /* Packet: 0x02 [DirChar] */
-    buf[0] = 0x02;
-    buf[1] = (uint8_t)dirChar;
+    /* Packet: 0x07 [Seq] [Count] [Flags] [AckTicksLow] [AckTicksHigh] [DirNibbles...]
+     * Directions are u/d/l/r = 0-3, two per byte, first step in the low
+     * nibble. Every queued step and the world delta cost one round trip. */
+    move_seq++;
+    buf[0] = 0x07;
+    buf[1] = move_seq;
+    buf[2] = count;
+    buf[3] = delta_need_full ? DELTA_FLAG_FULL : 0;
+    buf[4] = (uint8_t)(delta_ack_ticks & 0xFF);
+    buf[5] = (uint8_t)(delta_ack_ticks >> 8);
+    for (i = 0; i < count; i++) {
+        switch (dirs[i]) {
+            case 'u': nibble = 0; break;
+            case 'd': nibble = 1; break;
+            case 'l': nibble = 2; break;
+            default:  nibble = 3; break;
+        }
+        if (i & 1) {
+            buf[6 + (i >> 1)] |= (uint8_t)(nibble << 4);
+        } else {
+            buf[6 + (i >> 1)] = nibble;
+        }
+    }
     
-    if (network_write(tcp_device_spec, buf, 2) != FN_ERR_OK) {
+    if (network_write(tcp_device_spec, buf, 6 + ((count + 1) >> 1)) != FN_ERR_OK) {
         mark_disconnected();
         return 0;
     }
     
-    /* Resp: 0x02 [X] [Y] [Health] [Collision] [MsgLen] [Msg...] [LoserIdLen] [LoserId...] */
-    len = network_read(tcp_device_spec, buf, 6);
-    if (len < 6 || buf[0] != 0x02) {
+    /* Resp: 0x07 [Seq] [Count] then per applied step:
+     * [X16] [Y16] [Health] [Collision] [MsgLen] [Msg...] [LoserIdLen] [LoserId...]
+     * The server stops early if a step kills us, so Count can be smaller
+     * than the number sent. Only one batch is in flight, so the echo must
+     * match it. */
+    if (!read_reply_type(0x07) || rx_len < 3 || rx_buf[1] != move_seq) {
         mark_disconnected();
         return 0;
     }
+    result->seq = rx_buf[1];
+    steps = rx_buf[2];
     
-    result->x = buf[1];
-    result->y = buf[2];
-    /* Update local player health too? */
     local = state_get_local_player();
-    if (local) {
-        ((player_state_t*)local)->health = buf[3];
-        ((player_state_t*)local)->x = result->x;
-        ((player_state_t*)local)->y = result->y;
-    }
-    
-    result->collision = buf[4];
-    
-    /* Read battle message if present */
-    {
-        uint8_t msgLen = buf[5];
-        if (msgLen > 0) {
-            if (msgLen >= sizeof(buf)) {
-                mark_disconnected();
-                return 0;
-            }
-            len = network_read(tcp_device_spec, buf, msgLen);
-            if (len == msgLen) {
-                uint8_t copyLen = msgLen;
-                if (copyLen > 40) copyLen = 40;
-                memcpy(result->messages[0], buf, copyLen);
-                result->messages[0][copyLen] = '\0';
-                if (copyLen > 0) {
-                    result->message_count = 1;
-                    /* Store in state for non-blocking display */
-                    state_set_combat_message(result->messages[0]);
-                }
-            } else {
-                mark_disconnected();
-                return 0;
-            }
+    pos = 3;
+    for (i = 0; i < steps; i++) {
+        if ((uint16_t)(pos + 7) > rx_len) {
+            mark_disconnected();
+            return 0;
+        }
+        
+        /* Authoritative position after the last step; the caller
+         * reconciles its prediction */
+        result->x = RX_U16(pos);
+        result->y = RX_U16(pos + 2);
+        if (local) {
+            ((player_state_t*)local)->health = rx_buf[pos + 4];
+        }
+        if (rx_buf[pos + 5]) {
+            result->collision = 1;
+        }
+        
+        /* Battle message if present */
+        msgLen = rx_buf[pos + 6];
+        pos += 7;
+        if ((uint16_t)(pos + msgLen + 1) > rx_len) {
+            mark_disconnected();
+            return 0;
+        }
+        if (msgLen > 0 && result->message_count < 4) {
+            char *msg = result->messages[result->message_count++];
+            uint8_t copyLen = msgLen;
+            if (copyLen > 40) copyLen = 40;
+            memcpy(msg, &rx_buf[pos], copyLen);
+            msg[copyLen] = '\0';
+            /* Store in state for non-blocking display; the latest wins */
+            state_set_combat_message(msg);
+        }
+        pos += msgLen;
+        
+        /* Loser ID for death handling; keep the latest fight's */
+        loserLen = rx_buf[pos++];
+        if ((uint16_t)(pos + loserLen) > rx_len) {
+            mark_disconnected();
+            return 0;
         }
-    }
-
-    /* Read loser ID for death handling (optional for backward compatibility) */
-    len = network_read(tcp_device_spec, buf, 1);
-    if (len == 1) {
-        uint8_t loserLen = buf[0];
         if (loserLen > 0) {
-            if (loserLen >= sizeof(buf)) {
-                mark_disconnected();
-                return 0;
-            }
-            len = network_read(tcp_device_spec, buf, loserLen);
-            if (len != loserLen) {
-                mark_disconnected();
-                return 0;
-            }
-            if (loserLen >= sizeof(result->loser_id)) loserLen = sizeof(result->loser_id) - 1;
-            memcpy(result->loser_id, buf, loserLen);
-            result->loser_id[loserLen] = '\0';
+            uint8_t copyLen = loserLen;
+            if (copyLen >= sizeof(result->loser_id)) copyLen = sizeof(result->loser_id) - 1;
+            memcpy(result->loser_id, &rx_buf[pos], copyLen);
+            result->loser_id[copyLen] = '\0';
         }
-    } else {
+        pos += loserLen;
+    }
+
+    /* The 0x04 delta follows the move results; rx_buf is reused for it */
+    if (!read_reply_type(0x04) || !apply_delta_frame()) {
         mark_disconnected();
         return 0;
     }
@@ -312,8 +359,8 @@ static uint8_t kz_network_move_player_tcp(const char *player_id, const char *dir
     return 1;
 }
 
-uint8_t kz_network_move_player(const char *player_id, const char *direction, move_result_t *result) {
-    if (USE_TCP) return kz_network_move_player_tcp(player_id, direction, result);
+uint8_t kz_network_move_player(const char *player_id, const char *dirs, uint8_t count, move_result_t *result) {
+    if (USE_TCP) return kz_network_move_player_tcp(player_id, dirs, count, result);
     return 0;
 }
 
@@ -322,105 +369,194 @@ uint8_t kz_network_leave_player(const char *player_id) {
     return 1;
 }
 
-static player_state_t other_players[MAX_OTHER_PLAYERS];
+/* Read one whole frame into rx_buf: one header read, one body read.
+ * Reads block, so the keyboard is drained into the input queue before
+ * each one; keys pressed during a slow round trip are not lost. */
+static uint8_t read_frame(void) {
+    static uint8_t hdr[2];
+    uint16_t frame_len;
+    uint16_t skip;
+    uint16_t chunk;
+
+    input_poll();
+    if (network_read(tcp_device_spec, hdr, 2) != 2) {
+        return 0;
+    }
+    frame_len = (uint16_t)hdr[0] | ((uint16_t)hdr[1] << 8);
+    if (frame_len == 0) {
+        return 0;
+    }
+
+    rx_len = frame_len > RX_FRAME_SIZE ? RX_FRAME_SIZE : frame_len;
+    input_poll();
+    if (network_read(tcp_device_spec, rx_buf, rx_len) != (int)rx_len) {
+        return 0;
+    }
+
+    /* A snapshot bigger than rx_buf: keep the head (parsers stop at rx_len)
+     * and discard the tail into the scratch body buffer */
+    for (skip = frame_len - rx_len; skip > 0; skip -= chunk) {
+        chunk = skip > sizeof(body_buf) ? sizeof(body_buf) : skip;
+        input_poll();
+        if (network_read(tcp_device_spec, (uint8_t*)body_buf, chunk) != (int)chunk) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Apply the 0x04 frame held in rx_buf to the world state */
+static uint8_t apply_delta_frame(void) {
+    uint16_t pos;
+    uint8_t count;
+    uint8_t i;
+    uint8_t flags;
+    char typeChar;
+    const player_state_t *local;
+    uint8_t msgLen;
+    uint16_t ticks;
+
+    /* 0x04 [Flags] [TicksLow] [TicksHigh] [MsgLen] [Msg...]
+     * [RemovedCount] [Handle...] [UpsertCount] [Handle Type X16 Y16]... */
+    if (rx_len < 5) {
+        return 0;
+    }
+    
+    flags = rx_buf[1];
+    ticks = (uint16_t)rx_buf[2] | ((uint16_t)rx_buf[3] << 8);
+    state_set_world_ticks(ticks);
+
+    /* Message is only sent when it changed since our baseline */
+    msgLen = rx_buf[4];
+    pos = 5;
+    if (msgLen >= 40 || (uint16_t)(pos + msgLen) >= rx_len) {
+        return 0;
+    }
+    if (msgLen > 0) {
+        memcpy(value_buf, &rx_buf[pos], msgLen);
+        value_buf[msgLen] = '\0';
+        state_set_combat_message(value_buf);
+        pos += msgLen;
+    }
+
+    if (flags & DELTA_FLAG_FULL) {
+        state_clear_other_players();
+    }
+
+    /* Removed handles */
+    count = rx_buf[pos++];
+    if ((uint16_t)(pos + count) >= rx_len) {
+        return 0;
+    }
+    for (i = 0; i < count; i++) {
+        state_remove_other(rx_buf[pos++]);
+    }
+
+    /* Added or moved entities; a truncated snapshot stops at rx_len */
+    count = rx_buf[pos++];
+    
+    local = state_get_local_player();
+    
+    for (i = 0; i < count && (uint16_t)(pos + 6) <= rx_len; i++, pos += 6) {
+        /* 6 bytes: Handle, Type, X16, Y16 */
+        typeChar = (char)rx_buf[pos + 1];
+        
+        if (typeChar == 'M') {
+            /* Me / Local Player - update if moved externally? */
+            if (local) {
+                 ((player_state_t*)local)->handle = rx_buf[pos];
+                 ((player_state_t*)local)->x = RX_U16(pos + 2);
+                 ((player_state_t*)local)->y = RX_U16(pos + 4);
+            }
+            continue;
+        }
+        
+        state_upsert_other(rx_buf[pos],
+                           typeChar == 'P' ? ENTITY_PLAYER : (typeChar == 'H' ? ENTITY_HUNTER : ENTITY_ENEMY),
+                           RX_U16(pos + 2), RX_U16(pos + 4));
+    }
+    
+    delta_ack_ticks = ticks;
+    delta_need_full = 0;
+    return 1;
+}
+
+/* Read the next reply frame into rx_buf, applying any pushed 0x04 frames
+ * that were queued ahead of it. Returns 1 if the reply type matches. */
+static uint8_t read_reply_type(uint8_t expected) {
+    for (;;) {
+        if (!read_frame()) {
+            return 0;
+        }
+        if (rx_buf[0] == expected) {
+            return 1;
+        }
+        if (rx_buf[0] != 0x04 || !apply_delta_frame()) {
+            return 0;
+        }
+    }
+}
 
 uint8_t kz_network_get_world_state(void) {
     if (USE_TCP) {
-        static uint8_t buf[256]; /* Large buffer static */
-        int len;
-        uint8_t count;
-        uint8_t i;
-        uint8_t actual_count = 0;
-        char typeChar;
-        uint8_t x, y;
-        const player_state_t *local;
-        uint8_t msgLen;
+        uint8_t req[4];
 
         if (!tcp_connected) {
             mark_disconnected();
             return 0;
         }
         
-        buf[0] = 0x03;
-        if (network_write(tcp_device_spec, buf, 1) != FN_ERR_OK) {
+        /* Packet: 0x04 [Flags] [AckTicksLow] [AckTicksHigh] */
+        req[0] = 0x04;
+        req[1] = delta_need_full ? DELTA_FLAG_FULL : 0;
+        req[2] = (uint8_t)(delta_ack_ticks & 0xFF);
+        req[3] = (uint8_t)(delta_ack_ticks >> 8);
+        if (network_write(tcp_device_spec, req, 4) != FN_ERR_OK) {
             mark_disconnected();
             return 0;
         }
         
-        /* Resp: 0x03 [Count] [TicksLow] [TicksHigh] [MsgLen] [Msg...] [Entities...] */
-        len = network_read(tcp_device_spec, buf, 5);
-        if (len < 5 || buf[0] != 0x03) {
+        if (!read_reply_type(0x04) || !apply_delta_frame()) {
             mark_disconnected();
             return 0;
         }
-        
-        count = buf[1];
-        {         
-            uint16_t ticks = (uint16_t)buf[2] | ((uint16_t)buf[3] << 8);
-            state_set_world_ticks(ticks);
+        mark_connected();
+        return 1;
+    }
+    mark_disconnected();
+    return 0;
+}
+
+uint8_t kz_network_drain_updates(void) {
+    uint16_t bytes_waiting;
+    uint8_t connected;
+    uint8_t err;
+    uint8_t frames;
+
+    if (!tcp_connected) {
+        mark_disconnected();
+        return 0;
+    }
+
+    /* Bounded so a burst of pushes cannot stall rendering for long */
+    for (frames = 0; frames < MAX_DRAIN_FRAMES; frames++) {
+        if (network_status(tcp_device_spec, &bytes_waiting, &connected, &err) != FN_ERR_OK) {
+            mark_disconnected();
+            return 0;
         }
-        /* Read message if present */
-        msgLen = buf[4];
-        if (msgLen > 0 && msgLen < 40) {
-            len = network_read(tcp_device_spec, buf, msgLen);
-            if (len == msgLen) {
-                buf[msgLen] = '\0';
-                state_set_combat_message((char*)buf);
-            } else {
-                mark_disconnected();
-                return 0;
-            }
-        } else if (msgLen >= 40) {
+        if (!connected) {
             mark_disconnected();
             return 0;
         }
-        
-        local = state_get_local_player();
-        
-        for (i = 0; i < count; i++) {
-            /* Read 3 bytes: Type, X, Y */
-            len = network_read(tcp_device_spec, buf, 3);
-            if (len < 3) {
-                mark_disconnected();
-                return 0;
-            }
-            
-            typeChar = (char)buf[0];
-            x = buf[1];
-            y = buf[2];
-            
-            if (typeChar == 'M') {
-                /* Me / Local Player - update if moved externally? */
-                if (local) {
-                     ((player_state_t*)local)->x = x;
-                     ((player_state_t*)local)->y = y;
-                }
-                continue;
-            }
-            
-            if (actual_count < MAX_OTHER_PLAYERS) {
-                player_state_t *p = &other_players[actual_count];
-                /* We don't have ID or Name in simplified packet, just position/type */
-                /* This is a limitation of the simplified protocol, we just render them blindly */
-                /* For full feature parity we need IDs */
-                /* But for "bouncy" style, it's just visual. */
-                p->x = x;
-                p->y = y;
-                p->isHunter = (typeChar == 'H');
-                
-                if (typeChar == 'P') strcpy(p->type, "player");
-                else strcpy(p->type, "mob");
-                
-                actual_count++;
-            }
+        if (bytes_waiting == 0) {
+            break;
+        }
+        if (!read_frame() || rx_buf[0] != 0x04 || !apply_delta_frame()) {
+            mark_disconnected();
+            return 0;
         }
-        
-        state_set_other_players(other_players, actual_count);
-        mark_connected();
-        return 1;
     }
-    mark_disconnected();
-    return 0;
+    return 1;
 }
 
 uint8_t kz_network_get_player_status(const char *player_id, player_state_t *player) {
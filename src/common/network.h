@@ -28,9 +28,10 @@ typedef enum {
 
 /* Move result structure */
 typedef struct {
-    uint8_t x;
-    uint8_t y;
+    uint16_t x;
+    uint16_t y;
     uint8_t collision;
+    uint8_t seq;          /* Sequence number of the move this answers */
     char messages[4][41];
     uint8_t message_count;
     char loser_id[32];
@@ -54,11 +55,23 @@ uint8_t kz_network_join_player(const char *name, player_state_t *player);
 /* Returns 1 if success, 0 if failed. Updates global state directly. */
 uint8_t kz_network_get_world_state(void);
 
+/* Apply any world updates the server pushed since the last call, using the
+ * FujiNet bytes-waiting status so nothing is sent when the world is idle.
+ * Returns 1 if success, 0 if the connection failed. */
+uint8_t kz_network_drain_updates(void);
+
 /* Returns 1 if success, 0 if failed. Populates player struct. */
 uint8_t kz_network_get_player_status(const char *player_id, player_state_t *player);
 
-/* Returns 1 if success, 0 if failed. Populates result struct. */
-uint8_t kz_network_move_player(const char *player_id, const char *direction, move_result_t *result);
+/* Moves sent in one batch. Each step's result can carry a 39-byte message
+ * and 31-byte loser ID, so 4 steps always fit the 512-byte frame buffer
+ * (the server accepts up to 8). */
+#define MAX_MOVE_BATCH 4
+
+/* Apply count steps in order ('u', 'd', 'l' or 'r' each) with one round
+ * trip. Returns 1 if success, 0 if failed. Populates result struct with the
+ * final position, up to 4 combat messages and the latest loser ID. */
+uint8_t kz_network_move_player(const char *player_id, const char *dirs, uint8_t count, move_result_t *result);
 
 /* Returns 1 if success, 0 if failed. */
 uint8_t kz_network_leave_player(const char *player_id);
@@ -18,10 +18,10 @@
 /* Global state */
 static client_state_t current_state = STATE_INIT;
 static player_state_t local_player;
-static player_state_t other_players[MAX_OTHER_PLAYERS];
+static entity_t other_players[MAX_OTHER_PLAYERS];
 static uint8_t other_player_count = 0;
-static uint8_t world_width = 40;
-static uint8_t world_height = 20;
+static uint16_t world_width = 40;   /* Replaced by the join reply */
+static uint16_t world_height = 20;
 static uint16_t world_ticks = 0;
 char error_message[128];
 static int is_rejoining = 0;
@@ -116,7 +116,7 @@ void state_clear_local_player(void) {
 /**
  * Update local player position
  */
-void state_update_local_position(uint8_t x, uint8_t y) {
+void state_update_local_position(uint16_t x, uint16_t y) {
     local_player.x = x;
     local_player.y = y;
 }
@@ -129,24 +129,73 @@ void state_update_local_health(uint8_t health) {
 }
 
 /**
- * Set other players in world
+ * Find the slot holding a server entity handle, or 255
  */
-void state_set_other_players(const player_state_t *players, uint8_t count) {
-    if (count > MAX_OTHER_PLAYERS) {
-        count = MAX_OTHER_PLAYERS;
+static uint8_t find_other_slot(uint8_t handle) {
+    uint8_t i;
+
+    for (i = 0; i < other_player_count; i++) {
+        if (other_players[i].handle == handle) {
+            return i;
+        }
     }
-    
-    if (players && count > 0) {
-        memcpy(other_players, players, count * sizeof(player_state_t));
+    return 255;
+}
+
+/**
+ * Add or move a remote entity
+ */
+void state_upsert_other(uint8_t handle, uint8_t kind, uint16_t x, uint16_t y) {
+    entity_t *e;
+    uint8_t slot = find_other_slot(handle);
+
+    if (slot == 255) {
+        if (other_player_count >= MAX_OTHER_PLAYERS) {
+            return; /* No room; shown once it moves and a slot frees up */
+        }
+        slot = other_player_count++;
     }
-    
-    other_player_count = count;
+
+    e = &other_players[slot];
+    e->x = x;
+    e->y = y;
+    e->kind = kind;
+    e->handle = handle;
+}
+
+/**
+ * Remove a remote entity (the last entry fills the gap)
+ */
+void state_remove_other(uint8_t handle) {
+    uint8_t slot = find_other_slot(handle);
+
+    if (slot == 255) {
+        return;
+    }
+    other_player_count--;
+    if (slot != other_player_count) {
+        other_players[slot] = other_players[other_player_count];
+    }
+}
+
+/**
+ * Check whether any remote entity stands at a cell
+ */
+uint8_t state_other_at(uint16_t x, uint16_t y) {
+    uint8_t i;
+
+    for (i = 0; i < other_player_count; i++) {
+        if (other_players[i].x == x && other_players[i].y == y) {
+            return 1;
+        }
+    }
+    return 0;
 }
 
 /**
  * Get other players in world
  */
-const player_state_t *state_get_other_players(uint8_t *count) {
+const entity_t *state_get_other_players(uint8_t *count) {
     if (count) {
         *count = other_player_count;
     }
@@ -164,7 +213,7 @@ void state_clear_other_players(void) {
 /**
  * Set world dimensions
  */
-void state_set_world_dimensions(uint8_t width, uint8_t height) {
+void state_set_world_dimensions(uint16_t width, uint16_t height) {
     world_width = width;
     world_height = height;
 }
@@ -172,14 +221,14 @@ void state_set_world_dimensions(uint8_t width, uint8_t height) {
 /**
  * Get world width
  */
-uint8_t state_get_world_width(void) {
+uint16_t state_get_world_width(void) {
     return world_width;
 }
 
 /**
  * Get world height
  */
-uint8_t state_get_world_height(void) {
+uint16_t state_get_world_height(void) {
     return world_height;
 }
 
@@ -260,7 +309,7 @@ static uint8_t msg_contains(const char *haystack, const char *needle) {
 #endif
 
 /**
- * Set combat message (displays for ~30 frames then clears)
+ * Set combat message (displays for 30 message ticks then clears)
  */
 void state_set_combat_message(const char *msg) {
     if (msg && msg[0] != '\0') {
@@ -286,7 +335,7 @@ void state_set_combat_message(const char *msg) {
 #endif
         strncpy(combat_message, msg, 40);
         combat_message[40] = '\0';
-        combat_message_frames = 30;  /* Show for 30 frames */
+        combat_message_frames = 30;  /* Show for 30 ticks (3 seconds at 100ms) */
     }
 }
 
@@ -298,7 +347,7 @@ const char *state_get_combat_message(void) {
 }
 
 /**
- * Tick combat message counter - call each frame
+ * Tick combat message counter - called every 100ms by the main loop
  */
 void state_tick_combat_message(void) {
     if (combat_message_frames > 0) {
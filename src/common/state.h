@@ -21,21 +21,38 @@
 typedef struct {
     char id[32];
     char name[32];
-    uint8_t x;
-    uint8_t y;
+    uint16_t x;
+    uint16_t y;
     uint8_t health;
     char status[16];
     char type[8];  /* "player" or "mob" */
     int isHunter;  /* 1 if this is a hunter mob, 0 otherwise */
+    uint8_t handle; /* Server entity handle from delta state (0 = none) */
 } player_state_t;
 
+/* Remote entity kinds */
+typedef enum {
+    ENTITY_PLAYER = 0,
+    ENTITY_ENEMY = 1,
+    ENTITY_HUNTER = 2
+} entity_kind_t;
+
+/* Remote entity (other player or mob) - packed to 6 bytes. World
+ * coordinates are 16-bit so maps can be larger than one screen. */
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    uint8_t kind;   /* entity_kind_t */
+    uint8_t handle; /* Server entity handle from delta state */
+} entity_t;
+
 /* World state */
 typedef struct {
     player_state_t local_player;
-    player_state_t other_players[MAX_OTHER_PLAYERS];
+    entity_t other_players[MAX_OTHER_PLAYERS];
     uint8_t other_player_count;
-    uint8_t world_width;
-    uint8_t world_height;
+    uint16_t world_width;
+    uint16_t world_height;
     uint16_t world_ticks;
 } world_state_t;
 
@@ -70,18 +87,20 @@ void state_set_current(client_state_t new_state);
 void state_set_local_player(const player_state_t *player);
 const player_state_t *state_get_local_player(void);
 void state_clear_local_player(void);
-void state_update_local_position(uint8_t x, uint8_t y);
+void state_update_local_position(uint16_t x, uint16_t y);
 void state_update_local_health(uint8_t health);
 
-/* World state */
-void state_set_other_players(const player_state_t *players, uint8_t count);
-const player_state_t *state_get_other_players(uint8_t *count);
+/* World state (remote entities, keyed by server handle) */
+void state_upsert_other(uint8_t handle, uint8_t kind, uint16_t x, uint16_t y);
+void state_remove_other(uint8_t handle);
+const entity_t *state_get_other_players(uint8_t *count);
+uint8_t state_other_at(uint16_t x, uint16_t y);  /* 1 if a remote entity is at (x, y) */
 void state_clear_other_players(void);
 
 /* World dimensions */
-void state_set_world_dimensions(uint8_t width, uint8_t height);
-uint8_t state_get_world_width(void);
-uint8_t state_get_world_height(void);
+void state_set_world_dimensions(uint16_t width, uint16_t height);
+uint16_t state_get_world_width(void);
+uint16_t state_get_world_height(void);
 
 /* World ticks */
 void state_set_world_ticks(uint16_t ticks);
@@ -94,7 +113,7 @@ const char *state_get_server_version(void);
 /* Combat message (auto-clears after frames) */
 void state_set_combat_message(const char *msg);
 const char *state_get_combat_message(void);
-void state_tick_combat_message(void);  /* Call each frame to decrement counter */
+void state_tick_combat_message(void);  /* Call every 100ms to age the message */
 
 /* Error handling */
 void state_set_error(const char *message);
@@ -19,13 +19,13 @@
 #include <string.h>
 #include <ctype.h>
 #include <conio.h>
-#include <time.h>
 #endif
 
 #include "network.h"
 #include "state.h"
 #include "display.h"
 #include "input.h"
+#include "clock.h"
 #ifdef __ATARI__
 #include "atari_sound.h"
 #endif
@@ -51,26 +51,45 @@ void handle_state_error(void);
  * death/rejoin or connection-lost screens overwrote the display. */
 static int force_screen_refresh = 0;
 
+/* Gameplay tasks, run at fixed real-time intervals by the jiffy clock */
+static kz_task_t drain_task;    /* Apply pushed world updates */
+static kz_task_t status_task;   /* Redraw status bar and combat line */
+static kz_task_t message_task;  /* Age the combat message */
+
+/* Connect diagnostics stay up long enough to read: a connect attempt can
+ * fail faster than a single video frame. */
+#define CONNECT_PAUSE_MS 1000
+
 /**
- * Pause for roughly the given number of seconds so on-screen status
- * text is actually visible. A connect attempt can fail faster than a
- * single video frame, so the state machine needs an explicit pause or
- * diagnostic text never gets rendered before being overwritten.
+ * Predict where a step lands, clamped to the world bounds. Stepping onto
+ * a known entity is combat, which only the server can resolve, so that
+ * step predicts no movement.
  */
-static void kz_pause_seconds(uint8_t seconds) {
-#ifdef _CMOC_VERSION_
-    volatile unsigned long i;
-    unsigned long iterations = (unsigned long)seconds * 200000UL;
-    for (i = 0; i < iterations; i++) {
-        /* busy wait */
+static void predict_step(input_cmd_t cmd, uint16_t *x, uint16_t *y) {
+    uint16_t nx = *x;
+    uint16_t ny = *y;
+
+    switch (cmd) {
+        case CMD_UP:
+            if (ny > 0) ny--;
+            break;
+        case CMD_DOWN:
+            if (ny + 1 < state_get_world_height()) ny++;
+            break;
+        case CMD_LEFT:
+            if (nx > 0) nx--;
+            break;
+        case CMD_RIGHT:
+            if (nx + 1 < state_get_world_width()) nx++;
+            break;
+        default:
+            break;
     }
-#else
-    clock_t start = clock();
-    clock_t target = (clock_t)seconds * CLOCKS_PER_SEC;
-    while ((clock() - start) < target) {
-        /* busy wait */
+
+    if (!state_other_at(nx, ny)) {
+        *x = nx;
+        *y = ny;
     }
-#endif
 }
 
 /**
@@ -88,6 +107,10 @@ int main(void) {
  * Initialize game systems
  */
 void game_init(void) {
+    kz_clock_init();
+    kz_task_start(&drain_task, 100);
+    kz_task_start(&status_task, 250);
+    kz_task_start(&message_task, 100);
     state_init();
     display_init();
     input_init();
@@ -116,12 +139,10 @@ void game_close(void) {
  */
 void game_loop(void) {
     int running = 1;
-    int frame_count = 0;
     client_state_t current;
     
-    while (running && frame_count < 100000) {
+    while (running) {
         current = state_get_current();
-        frame_count++;
         
         switch (current) {
             case STATE_INIT:
@@ -151,9 +172,8 @@ void game_loop(void) {
                 break;
         }
 
-#ifdef __ATARI__
-        atari_sound_tick();
-#endif
+        /* One pass per video frame; idle rather than spin the work */
+        kz_clock_wait_frame();
     }
 
 }
@@ -175,12 +195,15 @@ void handle_state_init(void) {
 void handle_state_splash(void) {
     display_show_splash(SERVER_HOST, SERVER_TCP_PORT);
 #ifdef __ATARI__
-    /* Play the title jingle before blocking for a keypress. The melody
-     * routine is self-contained and blocks via RTCLOK, and there is no
-     * SIO activity yet at this point, so nothing competes for POKEY. */
+    /* The VBI sequencer plays the title jingle while we wait for a
+     * keypress. Cut it off on the key: connecting starts SIO traffic,
+     * which competes for POKEY. */
     atari_sound_play_melody();
 #endif
     input_wait_key();
+#ifdef __ATARI__
+    atari_sound_stop();
+#endif
     state_set_current(STATE_CONNECTING);
 }
 
@@ -204,23 +227,23 @@ void handle_state_connecting(void) {
 
     attempt++;
     display_show_connect_status(SERVER_HOST, SERVER_TCP_PORT, attempt, "connecting...");
-    kz_pause_seconds(1);
+    kz_clock_pause(CONNECT_PAUSE_MS);
 
     if (kz_network_health_check()) {
         display_show_connect_status(SERVER_HOST, SERVER_TCP_PORT, attempt, "connected!");
-        kz_pause_seconds(1);
+        kz_clock_pause(CONNECT_PAUSE_MS);
         state_set_current(STATE_JOINING);
     } else if (attempt > 10) {
         /* Give up after 10 attempts */
         snprintf(status_buf, sizeof(status_buf), "timed out (err %u)", kz_network_get_last_error());
         display_show_connect_status(SERVER_HOST, SERVER_TCP_PORT, attempt, status_buf);
-        kz_pause_seconds(2);
+        kz_clock_pause(2 * CONNECT_PAUSE_MS);
         state_set_error("Server not responding");
         state_set_current(STATE_ERROR);
     } else {
         snprintf(status_buf, sizeof(status_buf), "failed (err %u), retrying...", kz_network_get_last_error());
         display_show_connect_status(SERVER_HOST, SERVER_TCP_PORT, attempt, status_buf);
-        kz_pause_seconds(1);
+        kz_clock_pause(CONNECT_PAUSE_MS);
     }
 }
 
@@ -317,23 +340,27 @@ void handle_state_joining(void) {
  */
 
 void handle_state_playing(void) {
-    static int frame_count = 0;
     int c;
-    const char *direction = NULL;
+    input_cmd_t moves[MAX_MOVE_BATCH];
+    char dirs[MAX_MOVE_BATCH];
+    uint8_t move_count = 0;
+    uint8_t i;
     player_state_t *player;
     uint8_t player_count;
-    const player_state_t *others;
+    const entity_t *others;
     const char *status;
     move_result_t move_res;
     input_cmd_t cmd; /* Moved declaration to top */
     
-    /* Get world state periodically (every 20 frames). Less frequent than
-     * the original 5 - the SIO/NetSIO serial clock is audible while a
-     * transfer is in progress (real hardware behavior, not a bug), so
-     * polling less often leaves more quiet time between transfers for
-     * our own POKEY sound effects to be heard. */
-    if (frame_count++ % 20 == 0) {
-        if (!kz_network_get_world_state()) {
+    /* Drain world updates the server pushed since the last check. The
+     * server only sends when the world changed, so an idle world costs no
+     * network traffic - just a local FujiNet status query. Still checked
+     * every 100ms rather than every frame: the SIO/NetSIO serial clock
+     * is audible while a transfer is in progress (real hardware behavior,
+     * not a bug), and fewer transfers leave more quiet time for our own
+     * POKEY sound effects to be heard. */
+    if (kz_task_due(&drain_task)) {
+        if (!kz_network_drain_updates()) {
             /* Optional: handle network error during update */
         }
     }
@@ -351,8 +378,8 @@ void handle_state_playing(void) {
         display_render_game(player, others, player_count, do_refresh);
     }
     
-    /* Display status bar and combat message periodically (every 10 frames) */
-    if (frame_count % 10 == 0) {
+    /* Display status bar and combat message periodically (4 times a second) */
+    if (kz_task_due(&status_task)) {
         const char *combat_msg;
         player = (player_state_t *)state_get_local_player();
         if (player) {
@@ -367,24 +394,22 @@ void handle_state_playing(void) {
         }
     }
     
-    /* Tick combat message counter each frame */
-    state_tick_combat_message();
+    /* Age the combat message (expires after 30 ticks, 3 seconds) */
+    if (kz_task_due(&message_task)) {
+        state_tick_combat_message();
+    }
     
-    /* Check for input */
+    /* Check for input; keys pressed during the last round trip are queued */
     cmd = input_check();
     
     switch (cmd) {
         case CMD_UP:
-            direction = "up";
-            break;
         case CMD_DOWN:
-            direction = "down";
-            break;
         case CMD_LEFT:
-            direction = "left";
-            break;
         case CMD_RIGHT:
-            direction = "right";
+            /* Send this move and any queued right behind it as one batch */
+            moves[0] = cmd;
+            move_count = 1 + input_take_moves(&moves[1], MAX_MOVE_BATCH - 1);
             break;
         case CMD_REFRESH:
             /* Trigger full screen redraw */
@@ -400,6 +425,7 @@ void handle_state_playing(void) {
             
             /* Wait for confirmation */
             c = input_wait_key();
+            input_flush();
             if (c == 'y' || c == 'Y') {
                 /* Really quit - leave player and go to init */
                 kz_network_leave_player(player->id);
@@ -417,10 +443,29 @@ void handle_state_playing(void) {
             break;
     }
 
-    /* Send movement command if valid */
-    if (direction)
+    /* Send movement commands if any */
+    if (move_count > 0)
     {
-        if (!kz_network_move_player(player->id, direction, &move_res))
+        /* Move the '@' now rather than after the round trip */
+        uint16_t predicted_x = player->x;
+        uint16_t predicted_y = player->y;
+        for (i = 0; i < move_count; i++) {
+            predict_step(moves[i], &predicted_x, &predicted_y);
+            switch (moves[i]) {
+                case CMD_UP:    dirs[i] = 'u'; break;
+                case CMD_DOWN:  dirs[i] = 'd'; break;
+                case CMD_LEFT:  dirs[i] = 'l'; break;
+                default:        dirs[i] = 'r'; break;
+            }
+        }
+        if (predicted_x != player->x || predicted_y != player->y) {
+            player->x = predicted_x;
+            player->y = predicted_y;
+            others = state_get_other_players(&player_count);
+            display_render_game(player, others, player_count, 0);
+        }
+
+        if (!kz_network_move_player(player->id, dirs, move_count, &move_res))
         {
             /* If move failed (e.g. network error) */
             if (!state_is_connected())
@@ -430,6 +475,7 @@ void handle_state_playing(void) {
 
                 /* Wait for confirmation */
                 c = input_wait_key();
+                input_flush();
                 if (c == 'y' || c == 'Y')
                 {
                     /* Really quit - go to init */
@@ -451,9 +497,13 @@ void handle_state_playing(void) {
         }
         else
         {
-            /* Update local player position from response */
-            player->x = move_res.x;
-            player->y = move_res.y;
+            /* Reconcile with the server's authoritative position; only a
+             * misprediction (e.g. a player we had not seen yet) moves the
+             * '@' again */
+            if (move_res.x != predicted_x || move_res.y != predicted_y) {
+                player->x = move_res.x;
+                player->y = move_res.y;
+            }
 
             /* Check if combat occurred - message is auto-displayed via state */
             if (move_res.collision)
@@ -470,6 +520,8 @@ void handle_state_playing(void) {
 #ifdef __ATARI__
                         atari_sound_play_death();
 #endif
+                        /* Keys queued for the dead '@' are stale */
+                        input_flush();
                         state_set_current(STATE_DEAD);
                     }
                 }
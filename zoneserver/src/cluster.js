@@ -0,0 +1,37 @@
+/**
+ * KillZone Cluster Launcher
+ *
+ * Multi-process cluster mode: forks CLUSTER_PROCESSES zone processes that
+ * share CLUSTER_ZONES zones between them and routes each TCP client on
+ * TCP_PORT to the process hosting the zone its join packet asks for.
+ * Kills are announced cluster-wide. TCP only; the REST API is served by
+ * the single-process server (server.js).
+ */
+
+const os = require('os');
+const ClusterRouter = require('./cluster_router');
+const logger = require('./logger');
+const zoneOptions = require('./zone_options').fromEnv(); // World and Simulation settings
+
+const TCP_PORT = parseInt(process.env.TCP_PORT || '6809', 10);
+const PROCESSES = parseInt(process.env.CLUSTER_PROCESSES || String(os.cpus().length), 10);
+const ZONES = parseInt(process.env.CLUSTER_ZONES || String(PROCESSES), 10);
+const STATS_INTERVAL_MS = 60000;
+
+const router = new ClusterRouter(TCP_PORT, {
+  processes: PROCESSES,
+  zones: ZONES,
+  zone: zoneOptions
+});
+
+router.start().then(() => {
+  logger.info('cluster.start', { width: zoneOptions.width, height: zoneOptions.height, tickRate: zoneOptions.tickRate });
+  setInterval(() => {
+    logger.info('cluster.players', { players: router.playerCount(), zones: router.population });
+  }, STATS_INTERVAL_MS).unref();
+});
+
+process.on('SIGTERM', () => {
+  logger.info('server.shutdown', { signal: 'SIGTERM' });
+  router.stop().then(() => process.exit(0));
+});
@@ -0,0 +1,211 @@
+/**
+ * Cluster Router
+ *
+ * Front end for multi-process cluster mode. Forks N zone processes
+ * (zone_process.js) and spreads the zones over them, zone z living in
+ * process z % N. It owns the TCP port: each new connection is held until
+ * its first frame shows which zone it wants (a 0x08 join with the zone
+ * flag; anything else goes to zone 0), then the socket handle and the
+ * bytes read so far are passed to the owning process, which serves it
+ * from then on. The router also relays cross-zone events over IPC: kill
+ * messages are rebroadcast to every process for the global kill feed, and
+ * per-zone player counts are collected for cluster totals.
+ *
+ * A zone process that exits takes its clients with it; it is forked again
+ * after a short delay, and connections for its zones are refused until it
+ * is back. Connections that never send a first frame are dropped after
+ * the routing timeout.
+ */
+
+const net = require('net');
+const path = require('path');
+const { fork } = require('child_process');
+const TcpServer = require('./tcp_server');
+const logger = require('./logger');
+
+const PROCESS_PATH = path.join(__dirname, 'zone_process.js');
+const MAX_ROUTING_BYTES = 64; // Read at most this much before defaulting to zone 0
+const ROUTING_TIMEOUT_MS = 5000; // Drop a new connection that sends nothing this long
+const RESTART_DELAY_MS = 1000; // Pause before forking a replacement for a dead process
+
+class ClusterRouter {
+  /**
+   * @param {number} port - TCP port to listen on (0 picks a free one)
+   * @param {Object} options - Cluster configuration
+   * @param {number} options.processes - Zone processes to fork
+   * @param {number} options.zones - Zones in total (at least one per process)
+   * @param {Object} options.zone - World and Simulation settings of every zone (zone_options.js)
+   * @param {number} options.routingTimeoutMs - How long a new connection may
+   *   take to send its first frame
+   * @param {boolean} options.quiet - Silence zone process logging
+   */
+  constructor(port, options = {}) {
+    this.port = port;
+    this.options = options;
+    this.processCount = Math.max(1, options.processes || 1);
+    this.zoneCount = Math.max(this.processCount, options.zones || this.processCount);
+    this.routingTimeoutMs = options.routingTimeoutMs || ROUTING_TIMEOUT_MS;
+    this.children = []; // process index -> ChildProcess
+    this.population = new Array(this.zoneCount).fill(0); // zone -> players
+    this.stopping = false;
+    this.server = net.createServer(this.handleConnection.bind(this));
+  }
+
+  /**
+   * Fork the zone processes, then listen
+   * @returns {Promise} - Resolves once every process is ready and the port is open
+   */
+  async start() {
+    const ready = [];
+    for (let i = 0; i < this.processCount; i++) {
+      ready.push(this.startProcess(i));
+    }
+    await Promise.all(ready);
+    await new Promise(resolve => this.server.listen(this.port, resolve));
+    logger.info('tcp.listen', { port: this.server.address().port, zones: this.zoneCount, processes: this.processCount });
+  }
+
+  startProcess(index) {
+    const zones = [];
+    for (let zone = index; zone < this.zoneCount; zone += this.processCount) {
+      zones.push(zone);
+    }
+    const config = {
+      zones,
+      zone: this.options.zone || {},
+      quiet: !!this.options.quiet
+    };
+    const child = fork(PROCESS_PATH, [], {
+      env: Object.assign({}, process.env, { KZ_ZONE_CONFIG: JSON.stringify(config) })
+    });
+    child.ready = false;
+    this.children[index] = child;
+
+    child.on('message', msg => this.handleProcessMessage(msg));
+    child.on('error', err => logger.error('zone.failed', { process: index, error: err.message }));
+    child.on('exit', (code, signal) => this.handleProcessExit(index, child, zones, code, signal));
+
+    return new Promise((resolve, reject) => {
+      const onReady = (msg) => {
+        if (msg.type === 'ready') {
+          child.off('message', onReady);
+          child.ready = true;
+          resolve();
+        }
+      };
+      child.on('message', onReady);
+      child.once('error', reject);
+      child.once('exit', () => reject(new Error(`Zone process ${index} exited before it was ready`)));
+    });
+  }
+
+  /**
+   * A zone process is gone: forget its players and, unless we are
+   * shutting down, fork a replacement
+   */
+  handleProcessExit(index, child, zones, code, signal) {
+    child.ready = false;
+    for (const zone of zones) {
+      this.population[zone] = 0;
+    }
+    if (this.stopping || this.children[index] !== child) {
+      return;
+    }
+    logger.error('zone.exit', { process: index, code, signal });
+    setTimeout(() => {
+      if (!this.stopping) {
+        this.startProcess(index).catch(() => {}); // A failed start exits and retries
+      }
+    }, RESTART_DELAY_MS).unref();
+  }
+
+  /**
+   * Stop listening and shut down every zone process
+   */
+  async stop() {
+    this.stopping = true;
+    await new Promise(resolve => this.server.close(() => resolve()));
+    await Promise.all(this.children.map(child => new Promise((resolve) => {
+      if (child.exitCode !== null || child.signalCode !== null) {
+        resolve();
+        return;
+      }
+      child.once('exit', resolve);
+      if (child.connected) {
+        child.disconnect();
+      } else {
+        child.kill();
+      }
+    })));
+  }
+
+  /**
+   * Process that owns a zone
+   */
+  processFor(zone) {
+    return this.children[zone % this.processCount];
+  }
+
+  handleConnection(socket) {
+    let head = Buffer.alloc(0);
+    const timer = setTimeout(() => socket.destroy(), this.routingTimeoutMs);
+
+    const route = (zone) => {
+      clearTimeout(timer);
+      socket.off('data', onData);
+      socket.pause();
+      // Pick up anything buffered after the last 'data' event
+      let chunk;
+      while ((chunk = socket.read()) !== null) {
+        head = Buffer.concat([head, chunk]);
+      }
+      const target = zone < this.zoneCount ? zone : 0;
+      const child = this.processFor(target);
+      if (!child || !child.ready || !child.connected) {
+        socket.destroy(); // Its process is down; the client can reconnect
+        return;
+      }
+      child.send({ type: 'socket', zone: target, head: head.toString('base64') }, socket, (err) => {
+        if (err) {
+          socket.destroy();
+        }
+      });
+    };
+
+    const onData = (data) => {
+      head = Buffer.concat([head, data]);
+      const zone = TcpServer.joinZone(head);
+      if (zone !== undefined) {
+        route(zone === null ? 0 : zone);
+      } else if (head.length >= MAX_ROUTING_BYTES) {
+        route(0);
+      }
+    };
+
+    socket.on('data', onData);
+    socket.on('close', () => clearTimeout(timer));
+    socket.on('error', err => logger.warn('tcp.socket_error', { error: err.message }));
+  }
+
+  handleProcessMessage(msg) {
+    if (msg.type === 'kill') {
+      for (const child of this.children) {
+        if (child && child.connected) {
+          child.send(msg);
+        }
+      }
+    } else if (msg.type === 'population') {
+      this.population[msg.zone] = msg.players;
+    }
+  }
+
+  /**
+   * Players online across the whole cluster, as last reported
+   * @returns {number}
+   */
+  playerCount() {
+    return this.population.reduce((sum, players) => sum + players, 0);
+  }
+}
+
+module.exports = ClusterRouter;
@@ -0,0 +1,138 @@
+/**
+ * Delta Tracker
+ *
+ * Hands out stable one-byte entity handles and journals entity removals
+ * so the TCP delta state packet (0x04) can describe what changed since a
+ * client's acknowledged tick. Removals older than the history window are
+ * pruned; clients whose baseline predates the window get a full snapshot.
+ * Entities that arrive while every handle is taken wait in line for the
+ * next one released. Viewport clients number entities themselves
+ * (ViewHandles) and are not limited by this pool.
+ */
+
+const MAX_HANDLE = 255; // Handles are u8 on the wire; 0 means "no handle"
+
+class DeltaTracker {
+  /**
+   * @param {number} historyTicks - How many ticks of removals to keep
+   */
+  constructor(historyTicks = 100) {
+    this.historyTicks = historyTicks;
+    this.freeHandles = [];
+    for (let h = 1; h <= MAX_HANDLE; h++) {
+      this.freeHandles.push(h);
+    }
+    this.waiting = new Set(); // Entities in play without a handle, oldest first
+    this.removals = []; // [{ handle, tick }] in tick order
+    this.horizonTick = 0; // Oldest baseline that removals still cover
+  }
+
+  /**
+   * Assign a handle to an entity entering play
+   * @param {Object} entity - Player or Mob
+   */
+  assign(entity) {
+    if (entity.handle) {
+      return;
+    }
+    if (this.freeHandles.length === 0) {
+      entity.handle = 0;
+      this.waiting.add(entity);
+      return;
+    }
+    // FIFO reuse keeps a freed handle out of circulation as long as possible
+    entity.handle = this.freeHandles.shift();
+  }
+
+  /**
+   * Release an entity's handle and journal its removal. If an entity is
+   * waiting for a handle it takes this one, marked changed at the same
+   * tick so deltas carry the removal and then its arrival.
+   * @param {Object} entity - Player or Mob leaving play
+   * @param {number} tick - Tick the removal belongs to
+   */
+  release(entity, tick) {
+    if (!entity.handle) {
+      this.waiting.delete(entity);
+      return;
+    }
+    const handle = entity.handle;
+    this.removals.push({ handle, tick });
+    entity.handle = 0;
+
+    const next = this.waiting.values().next();
+    if (next.done) {
+      this.freeHandles.push(handle);
+      return;
+    }
+    this.waiting.delete(next.value);
+    next.value.handle = handle;
+    next.value.changedTick = tick;
+  }
+
+  /**
+   * Check whether a delta can be built from a baseline tick
+   * @param {number} baselineTick - Last tick the client applied
+   * @param {number} currentTick - Current world tick
+   * @returns {boolean} - True if removals since baseline are all journaled
+   */
+  canDeltaFrom(baselineTick, currentTick) {
+    return baselineTick >= this.horizonTick && baselineTick <= currentTick;
+  }
+
+  /**
+   * Get handles removed after a baseline tick
+   * @param {number} baselineTick - Last tick the client applied
+   * @returns {Array<number>} - Removed handles, oldest first, deduplicated
+   */
+  removedSince(baselineTick) {
+    const handles = [];
+    const seen = new Set();
+    for (let i = this.removals.length - 1; i >= 0; i--) {
+      const removal = this.removals[i];
+      if (removal.tick <= baselineTick) {
+        break;
+      }
+      if (!seen.has(removal.handle)) {
+        seen.add(removal.handle);
+        handles.push(removal.handle);
+      }
+    }
+    return handles.reverse();
+  }
+
+  /**
+   * Drop removals that fall outside the history window
+   * @param {number} currentTick - Current world tick
+   */
+  prune(currentTick) {
+    const horizon = currentTick - this.historyTicks;
+    if (horizon <= this.horizonTick) {
+      return;
+    }
+    let drop = 0;
+    while (drop < this.removals.length && this.removals[drop].tick <= horizon) {
+      drop++;
+    }
+    if (drop > 0) {
+      this.removals.splice(0, drop);
+    }
+    this.horizonTick = horizon;
+  }
+
+  /**
+   * Forget all handles and history; every existing baseline becomes stale
+   * @param {number} currentTick - Current world tick
+   */
+  reset(currentTick) {
+    this.waiting.clear();
+    this.freeHandles = [];
+    for (let h = 1; h <= MAX_HANDLE; h++) {
+      this.freeHandles.push(h);
+    }
+    this.removals = [];
+    this.horizonTick = currentTick + 1;
+  }
+}
+
+module.exports = DeltaTracker;
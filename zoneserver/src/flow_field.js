@@ -0,0 +1,109 @@
+/**
+ * Flow Field
+ *
+ * Distance from each cell to the nearest player, found by one multi-source
+ * breadth-first search per tick and shared by every hunter: a chasing mob
+ * reads its own cell and steps to a neighbour one closer, so pursuit costs
+ * a single sweep however many mobs are hunting. Steps only cross walkable
+ * cells, so paths go around anything World.isWalkable() rules out.
+ *
+ * The search stops at the hunt radius, and cells are stored sparsely, so
+ * the work and memory follow the area around players, not the map size.
+ */
+
+const STEPS = [[1, 0], [-1, 0], [0, 1], [0, -1]];
+
+class FlowField {
+  /**
+   * @param {number} width - Grid width in cells
+   * @param {number} height - Grid height in cells
+   */
+  constructor(width, height) {
+    this.width = width;
+    this.height = height;
+    this.distance = new Map(); // cell index -> steps to the nearest source
+    this.source = new Map(); // cell index -> the source that is nearest
+  }
+
+  /**
+   * Rebuild the field
+   * @param {Iterable} sources - Entities with x/y to measure distance to
+   * @param {number} maxDistance - Farthest distance recorded
+   * @param {Function} isWalkable - (x, y) => whether a cell can be entered
+   */
+  compute(sources, maxDistance, isWalkable) {
+    const distance = this.distance;
+    const source = this.source;
+    distance.clear();
+    source.clear();
+
+    let frontier = [];
+    for (const entity of sources) {
+      const index = this.indexOf(entity.x, entity.y);
+      if (index >= 0 && !distance.has(index)) {
+        distance.set(index, 0);
+        source.set(index, entity);
+        frontier.push(index);
+      }
+    }
+
+    for (let d = 1; d <= maxDistance && frontier.length > 0; d++) {
+      const next = [];
+      for (const index of frontier) {
+        const x = index % this.width;
+        const y = (index - x) / this.width;
+        for (const [sx, sy] of STEPS) {
+          const nx = x + sx;
+          const ny = y + sy;
+          const neighbour = this.indexOf(nx, ny);
+          if (neighbour < 0 || distance.has(neighbour) || !isWalkable(nx, ny)) {
+            continue;
+          }
+          distance.set(neighbour, d);
+          source.set(neighbour, source.get(index));
+          next.push(neighbour);
+        }
+      }
+      frontier = next;
+    }
+  }
+
+  /**
+   * Read the field at a cell
+   * @returns {Object|null} - { distance, target } or null if out of range
+   */
+  at(x, y) {
+    const index = this.indexOf(x, y);
+    const distance = this.distance.get(index);
+    if (distance === undefined) {
+      return null;
+    }
+    return { distance, target: this.source.get(index) };
+  }
+
+  /**
+   * Neighbouring cell one step closer to the nearest source
+   * @returns {Object|null} - { x, y }, or null at a source or out of range
+   */
+  nextStep(x, y) {
+    const here = this.distance.get(this.indexOf(x, y));
+    if (!here) {
+      return null;
+    }
+    for (const [sx, sy] of STEPS) {
+      if (this.distance.get(this.indexOf(x + sx, y + sy)) === here - 1) {
+        return { x: x + sx, y: y + sy };
+      }
+    }
+    return null;
+  }
+
+  indexOf(x, y) {
+    if (!(x >= 0 && x < this.width && y >= 0 && y < this.height)) {
+      return -1;
+    }
+    return y * this.width + x;
+  }
+}
+
+module.exports = FlowField;
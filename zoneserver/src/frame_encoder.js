@@ -0,0 +1,112 @@
+/**
+ * Frame Encoder
+ *
+ * Reusable scratch buffer for building TCP response frames. Fields are
+ * written into one preallocated buffer and finish() returns an exact-size
+ * copy, so a response costs one allocation no matter how many fields it
+ * has. The scratch buffer grows (and stays grown) if a frame outgrows it.
+ *
+ * Every frame starts with a u16 little-endian length counting the bytes
+ * that follow it, so clients can read a whole frame with one header read
+ * and one body read.
+ */
+
+const HEADER_SIZE = 2; // [LenLow] [LenHigh]
+
+class FrameEncoder {
+  /**
+   * @param {number} capacity - Initial scratch size in bytes
+   */
+  constructor(capacity = 2048) {
+    this.buf = Buffer.allocUnsafe(capacity);
+    this.offset = 0;
+  }
+
+  /**
+   * Start a new frame
+   * @returns {FrameEncoder} - this, for chaining
+   */
+  begin() {
+    this.offset = HEADER_SIZE;
+    return this;
+  }
+
+  ensure(extra) {
+    if (this.offset + extra <= this.buf.length) {
+      return;
+    }
+    const grown = Buffer.allocUnsafe(Math.max(this.buf.length * 2, this.offset + extra));
+    this.buf.copy(grown, 0, 0, this.offset);
+    this.buf = grown;
+  }
+
+  /**
+   * Append one byte
+   * @param {number} value - Byte value
+   */
+  u8(value) {
+    this.ensure(1);
+    this.buf[this.offset++] = value & 0xFF;
+    return this;
+  }
+
+  /**
+   * Append a 16-bit little-endian value
+   * @param {number} value - Value (truncated to 16 bits)
+   */
+  u16(value) {
+    this.ensure(2);
+    this.buf[this.offset++] = value & 0xFF;
+    this.buf[this.offset++] = (value >> 8) & 0xFF;
+    return this;
+  }
+
+  /**
+   * Append raw bytes
+   * @param {Buffer} bytes - Bytes to copy in
+   */
+  bytes(bytes) {
+    this.ensure(bytes.length);
+    bytes.copy(this.buf, this.offset);
+    this.offset += bytes.length;
+    return this;
+  }
+
+  /**
+   * Append a length-prefixed (u8) byte string
+   * @param {Buffer} bytes - Pre-encoded string bytes (at most 255)
+   */
+  lenBytes(bytes) {
+    return this.u8(bytes.length).bytes(bytes);
+  }
+
+  /**
+   * Append a length-prefixed (u8) string, truncated to maxLen characters
+   * @param {string} text - Text to encode
+   * @param {number} maxLen - Maximum characters kept
+   */
+  lenString(text, maxLen) {
+    const safe = (text || '').substring(0, maxLen);
+    this.ensure(1 + Buffer.byteLength(safe));
+    const written = this.buf.write(safe, this.offset + 1);
+    this.buf[this.offset] = written;
+    this.offset += 1 + written;
+    return this;
+  }
+
+  /**
+   * Copy the finished frame out of the scratch buffer
+   * @returns {Buffer} - Exact-size frame, safe to hand to socket.write()
+   */
+  finish() {
+    const bodyLen = this.offset - HEADER_SIZE;
+    this.buf[0] = bodyLen & 0xFF;
+    this.buf[1] = (bodyLen >> 8) & 0xFF;
+    const frame = Buffer.allocUnsafe(this.offset);
+    this.buf.copy(frame, 0, 0, this.offset);
+    return frame;
+  }
+}
+
+module.exports = FrameEncoder;
+module.exports.HEADER_SIZE = HEADER_SIZE;
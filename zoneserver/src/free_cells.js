@@ -0,0 +1,86 @@
+/**
+ * Free Cell Counts
+ *
+ * Number of unoccupied cells in each chunk of a SpatialGrid, kept in a
+ * Fenwick (binary indexed) tree so that both updating a chunk's count and
+ * finding the chunk holding the k-th free cell of the whole map cost
+ * O(log chunks). That is what lets spawning draw a uniformly random free
+ * cell without sampling and retrying, with memory of one counter per chunk
+ * however large the map is.
+ */
+
+class FreeCells {
+  /**
+   * @param {Array<number>} capacities - Cells in each chunk, all free to begin with
+   */
+  constructor(capacities) {
+    this.capacities = capacities;
+    this.tree = new Int32Array(capacities.length + 1);
+    this.top = 1; // Highest power of two <= chunk count, for find()
+    while (this.top * 2 <= capacities.length) {
+      this.top *= 2;
+    }
+    this.reset();
+  }
+
+  /**
+   * One cell of a chunk became occupied
+   * @param {number} chunk - Chunk slot
+   */
+  take(chunk) {
+    this.add(chunk, -1);
+  }
+
+  /**
+   * One cell of a chunk became free
+   * @param {number} chunk - Chunk slot
+   */
+  release(chunk) {
+    this.add(chunk, 1);
+  }
+
+  /**
+   * Locate the k-th free cell of the map (counting chunk by chunk)
+   * @param {number} k - 0 <= k < total
+   * @returns {Object} - { chunk, rank }: the chunk, and the cell's rank
+   *   among that chunk's free cells
+   */
+  find(k) {
+    let pos = 0;
+    let rest = k;
+    for (let step = this.top; step > 0; step >>= 1) {
+      const next = pos + step;
+      if (next < this.tree.length && this.tree[next] <= rest) {
+        pos = next;
+        rest -= this.tree[next];
+      }
+    }
+    return { chunk: pos, rank: rest };
+  }
+
+  /**
+   * Mark every cell free again
+   */
+  reset() {
+    const tree = this.tree;
+    tree.fill(0);
+    this.total = 0;
+    for (let i = 0; i < this.capacities.length; i++) {
+      tree[i + 1] += this.capacities[i];
+      this.total += this.capacities[i];
+      const parent = (i + 1) + ((i + 1) & -(i + 1));
+      if (parent < tree.length) {
+        tree[parent] += tree[i + 1];
+      }
+    }
+  }
+
+  add(chunk, delta) {
+    this.total += delta;
+    for (let i = chunk + 1; i < this.tree.length; i += i & -i) {
+      this.tree[i] += delta;
+    }
+  }
+}
+
+module.exports = FreeCells;
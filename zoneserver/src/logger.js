@@ -0,0 +1,194 @@
+/**
+ * Structured Logger
+ *
+ * Leveled JSON-lines logging that stays off the hot path:
+ * - Calls below the configured level return before building anything;
+ *   callers on hot paths check enabled() first so not even their field
+ *   objects are allocated.
+ * - High-frequency events (moves, state polls) can be sampled: with a
+ *   rate of N only every Nth occurrence is written, tagged `sampled: N`.
+ * - Lines are buffered and written to the stream in one chunk per flush
+ *   interval (or when the buffer fills), never synchronously per call.
+ *   While the stream applies backpressure lines stay buffered up to a
+ *   cap, past which they are counted as dropped rather than piling up.
+ *
+ * Configured from the environment: LOG_LEVEL (error, warn, info, debug
+ * or silent; default info, error under test) and LOG_SAMPLE, a list of
+ * event=rate pairs such as "tcp.move=100,http.state=50".
+ */
+
+const fs = require('fs');
+
+const LEVELS = { silent: -1, error: 0, warn: 1, info: 2, debug: 3 };
+const DEFAULT_SAMPLE = { 'tcp.move': 20, 'http.move': 20, 'http.state': 20 };
+const FLUSH_MS = 100;
+const MAX_BUFFER_BYTES = 64 * 1024; // Flush early once this much is waiting
+const MAX_PENDING_BYTES = 4 * 1024 * 1024; // Drop lines past this under backpressure
+
+class Logger {
+  /**
+   * @param {Object} options - See configure()
+   */
+  constructor(options = {}) {
+    this.buffer = [];
+    this.bufferedBytes = 0;
+    this.timer = null;
+    this.blocked = false; // Stream asked us to wait for 'drain'
+    this.dropped = 0;
+    this.counts = new Map(); // event -> occurrences, for sampling
+    this.configure(Object.assign({ level: 'info', stream: process.stdout, sample: DEFAULT_SAMPLE }, options));
+  }
+
+  /**
+   * Change settings
+   * @param {Object} options - Settings to change
+   * @param {string} options.level - Least severe level written
+   * @param {Object} options.sample - event -> write one in this many
+   * @param {Writable} options.stream - Where lines go
+   */
+  configure(options) {
+    if (options.level !== undefined) {
+      this.level = LEVELS[options.level] !== undefined ? options.level : 'info';
+      this.threshold = LEVELS[this.level];
+    }
+    if (options.sample !== undefined) {
+      this.sample = Object.assign({}, options.sample);
+      this.counts.clear();
+    }
+    if (options.stream !== undefined) {
+      this.flush();
+      this.stream = options.stream;
+      this.blocked = false;
+    }
+    return this;
+  }
+
+  /**
+   * Whether a level is written; guard hot-path calls with this
+   * @param {string} level - Level name
+   * @returns {boolean}
+   */
+  enabled(level) {
+    return LEVELS[level] <= this.threshold;
+  }
+
+  error(event, fields) {
+    this.write('error', event, fields);
+  }
+
+  warn(event, fields) {
+    this.write('warn', event, fields);
+  }
+
+  info(event, fields) {
+    this.write('info', event, fields);
+  }
+
+  debug(event, fields) {
+    this.write('debug', event, fields);
+  }
+
+  write(level, event, fields) {
+    if (LEVELS[level] > this.threshold) {
+      return;
+    }
+    const rate = this.sample[event];
+    let sampled;
+    if (rate > 1) {
+      const count = (this.counts.get(event) || 0) + 1;
+      this.counts.set(event, count === rate ? 0 : count);
+      if (count !== 1) {
+        return;
+      }
+      sampled = rate;
+    }
+    if (this.bufferedBytes > MAX_PENDING_BYTES) {
+      this.dropped++;
+      return;
+    }
+
+    const line = JSON.stringify(Object.assign({ time: Date.now(), level, event }, fields, sampled ? { sampled } : null));
+    this.buffer.push(line);
+    this.bufferedBytes += line.length + 1;
+    if (this.bufferedBytes >= MAX_BUFFER_BYTES) {
+      this.flush();
+    } else if (!this.timer) {
+      this.timer = setTimeout(() => this.flush(), FLUSH_MS);
+      this.timer.unref();
+    }
+  }
+
+  /**
+   * Hand everything buffered to the stream now
+   */
+  flush() {
+    if (this.timer) {
+      clearTimeout(this.timer);
+      this.timer = null;
+    }
+    if (this.buffer.length === 0 || this.blocked) {
+      return;
+    }
+    const chunk = this.takeBuffer();
+    if (!this.stream.write(chunk)) {
+      this.blocked = true;
+      this.stream.once('drain', () => {
+        this.blocked = false;
+        this.flush();
+      });
+    }
+  }
+
+  /**
+   * Write whatever is left synchronously (process exit)
+   */
+  flushSync() {
+    if (this.buffer.length === 0) {
+      return;
+    }
+    const chunk = this.takeBuffer();
+    if (typeof this.stream.fd === 'number') {
+      try {
+        fs.writeSync(this.stream.fd, chunk);
+      } catch (e) {
+        // Nowhere left to report it
+      }
+    } else {
+      this.stream.write(chunk);
+    }
+  }
+
+  takeBuffer() {
+    let chunk = this.buffer.join('\n') + '\n';
+    if (this.dropped > 0) {
+      chunk += JSON.stringify({ time: Date.now(), level: 'warn', event: 'log.dropped', count: this.dropped }) + '\n';
+      this.dropped = 0;
+    }
+    this.buffer = [];
+    this.bufferedBytes = 0;
+    return chunk;
+  }
+}
+
+/**
+ * Parse LOG_SAMPLE ("event=rate,...") over the default rates
+ */
+function parseSample(spec) {
+  const sample = Object.assign({}, DEFAULT_SAMPLE);
+  for (const pair of (spec || '').split(',')) {
+    const [event, rate] = pair.split('=');
+    if (event && rate) {
+      sample[event.trim()] = parseInt(rate, 10);
+    }
+  }
+  return sample;
+}
+
+const logger = new Logger({
+  level: process.env.LOG_LEVEL || (process.env.NODE_ENV === 'test' ? 'error' : 'info'),
+  sample: parseSample(process.env.LOG_SAMPLE)
+});
+process.on('exit', () => logger.flushSync());
+
+module.exports = logger;
+module.exports.Logger = Logger;
@@ -19,61 +19,42 @@ class Mob {
     this.moveInterval = Math.floor(Math.random() * 3) + 2; // Move every 2-4 ticks
     this.huntMoveCounter = 0;  // Counter for slowed hunting movement
     this.huntMoveInterval = 3;  // Move every 3 ticks when hunting (slower than normal)
+    this.world = null;  // Set by World while the mob is in play
   }
 
   /**
-   * Move mob randomly
-   * @param {number} worldWidth - World width boundary
-   * @param {number} worldHeight - World height boundary
-   */
-  /**
-   * Move toward target using Manhattan distance (with optional slowdown for hunting)
-   * @param {number} targetX - Target X coordinate
-   * @param {number} targetY - Target Y coordinate
-   * @param {number} worldWidth - World width boundary
-   * @param {number} worldHeight - World height boundary
-   * @param {boolean} slowHunt - If true, apply slowdown when very close (within 3 squares)
-   * @returns {boolean} - True if actually moved, false if slowed down
+   * Step one cell down a flow field toward its nearest target (with
+   * optional slowdown for hunting)
+   * @param {FlowField} field - Field computed this tick
+   * @param {boolean} slowHunt - If true, apply slowdown when very close (within 3 steps)
+   * @returns {boolean} - True if actually moved
    */
-  moveToward(targetX, targetY, worldWidth, worldHeight, slowHunt = false) {
-    // If slowHunt is enabled and target is very close, apply slowdown
-    if (slowHunt) {
-      const distance = Math.abs(this.x - targetX) + Math.abs(this.y - targetY);
-      
-      // Within 3 squares: apply slowdown (move every 3 ticks instead of every tick)
-      if (distance <= 3) {
-        this.huntMoveCounter++;
-        if (this.huntMoveCounter < this.huntMoveInterval) {
-          return false;  // Don't move this tick
-        }
-        this.huntMoveCounter = 0;  // Reset counter
+  moveAlong(field, slowHunt = false) {
+    const here = field.at(this.x, this.y);
+    if (!here) {
+      return false;
+    }
+    if (slowHunt && here.distance <= 3) {
+      this.huntMoveCounter++;
+      if (this.huntMoveCounter < this.huntMoveInterval) {
+        return false;  // Don't move this tick
       }
+      this.huntMoveCounter = 0;
     }
-    
-    const dx = targetX - this.x;
-    const dy = targetY - this.y;
-    
-    let newX = this.x;
-    let newY = this.y;
-    
-    // Prefer moving in the direction with larger distance
-    if (Math.abs(dx) > Math.abs(dy)) {
-      // Move horizontally
-      newX = this.x + (dx > 0 ? 1 : -1);
-    } else {
-      // Move vertically
-      newY = this.y + (dy > 0 ? 1 : -1);
+
+    const step = field.nextStep(this.x, this.y);
+    if (!step) {
+      return false;
     }
-    
-    // Clamp to world boundaries
-    newX = Math.max(0, Math.min(worldWidth - 1, newX));
-    newY = Math.max(0, Math.min(worldHeight - 1, newY));
-    
-    this.x = newX;
-    this.y = newY;
-    return true;  // Actually moved
+    this.setPosition(step.x, step.y);
+    return true;
   }
 
+  /**
+   * Move mob randomly
+   * @param {number} worldWidth - World width boundary
+   * @param {number} worldHeight - World height boundary
+   */
   moveRandom(worldWidth, worldHeight) {
     this.moveCounter++;
     if (this.moveCounter < this.moveInterval) {
@@ -104,8 +85,7 @@ class Mob {
         break;
     }
     
-    this.x = newX;
-    this.y = newY;
+    this.setPosition(newX, newY);
   }
 
   /**
@@ -116,6 +96,9 @@ class Mob {
   setPosition(x, y) {
     this.x = x;
     this.y = y;
+    if (this.world) {
+      this.world.entityMoved(this);
+    }
   }
 
   /**
@@ -17,6 +17,8 @@ class Player {
     this.status = 'alive'; // alive, dead, waiting
     this.joinedAt = Date.now();
     this.type = 'player';
+    this.world = null; // Set by World while the player is in play
+    this.inactivityTimer = null; // World timer that drops the player when idle
   }
 
   /**
@@ -27,6 +29,9 @@ class Player {
   setPosition(x, y) {
     this.x = x;
     this.y = y;
+    if (this.world) {
+      this.world.entityMoved(this);
+    }
   }
 
   /**
@@ -0,0 +1,120 @@
+/**
+ * Reconnect Cache
+ *
+ * Holds players who left the world so a returning name gets its old
+ * identity back, bounded in both size and age: at most `capacity` entries,
+ * least recently stored evicted first, and each entry expires `ttlMs`
+ * after it was stored. World.tick() sweeps expired entries, so memory
+ * stays flat however many one-off players pass through.
+ *
+ * Entries live in a Map in insertion order. Storing a name re-inserts it
+ * at the back, and every entry has the same TTL, so the front of the Map
+ * is both the least recently stored and the first to expire: eviction and
+ * the expiry sweep only ever look at the front.
+ */
+
+const DEFAULT_CAPACITY = 1024;
+const DEFAULT_TTL_MS = 30 * 60 * 1000; // 30 minutes
+
+class ReconnectCache {
+  /**
+   * @param {number} capacity - Most entries kept
+   * @param {number} ttlMs - How long an entry is kept after it was stored
+   */
+  constructor(capacity = DEFAULT_CAPACITY, ttlMs = DEFAULT_TTL_MS) {
+    this.capacity = capacity;
+    this.ttlMs = ttlMs;
+    this.entries = new Map(); // key -> { value, expiresAt }
+    this.hits = 0;
+    this.misses = 0;
+    this.evictions = 0; // Dropped to make room
+    this.expirations = 0; // Dropped for age
+  }
+
+  get size() {
+    return this.entries.size;
+  }
+
+  /**
+   * Store an entry, replacing any older one under the same key
+   * @param {string} key - Player name
+   * @param {*} value - Player object
+   * @param {number} now - Current time in ms
+   */
+  set(key, value, now = Date.now()) {
+    this.entries.delete(key);
+    this.entries.set(key, { value, expiresAt: now + this.ttlMs });
+    while (this.entries.size > this.capacity) {
+      this.entries.delete(this.entries.keys().next().value);
+      this.evictions++;
+    }
+  }
+
+  /**
+   * Look up an entry, counting a hit or a miss. Entries past their TTL
+   * that the sweep has not reached yet count as misses.
+   * @param {string} key - Player name
+   * @param {number} now - Current time in ms
+   * @returns {*} - Stored value, or null
+   */
+  get(key, now = Date.now()) {
+    const entry = this.entries.get(key);
+    if (!entry || entry.expiresAt <= now) {
+      this.misses++;
+      return null;
+    }
+    this.hits++;
+    return entry.value;
+  }
+
+  /**
+   * Whether a live entry exists, without touching the counters
+   */
+  has(key, now = Date.now()) {
+    const entry = this.entries.get(key);
+    return !!entry && entry.expiresAt > now;
+  }
+
+  delete(key) {
+    return this.entries.delete(key);
+  }
+
+  /**
+   * Drop every entry past its TTL
+   * @param {number} now - Current time in ms
+   * @returns {number} - Entries dropped
+   */
+  expire(now = Date.now()) {
+    let dropped = 0;
+    for (const [key, entry] of this.entries) {
+      if (entry.expiresAt > now) {
+        break;
+      }
+      this.entries.delete(key);
+      dropped++;
+    }
+    this.expirations += dropped;
+    return dropped;
+  }
+
+  clear() {
+    this.entries.clear();
+  }
+
+  /**
+   * Counters for monitoring
+   * @returns {Object} - { size, capacity, hits, misses, evictions, expirations }
+   */
+  stats() {
+    return {
+      size: this.entries.size,
+      capacity: this.capacity,
+      hits: this.hits,
+      misses: this.misses,
+      evictions: this.evictions,
+      expirations: this.expirations
+    };
+  }
+}
+
+module.exports = ReconnectCache;
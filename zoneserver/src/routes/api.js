@@ -8,6 +8,7 @@ const express = require('express');
 const Player = require('../player');
 const CollisionDetector = require('../collision');
 const CombatResolver = require('../combat');
+const logger = require('../logger');
 
 function createApiRoutes(world) {
   const router = express.Router();
@@ -18,11 +19,11 @@ function createApiRoutes(world) {
    */
   router.get('/health', (req, res) => {
     const playerCount = world.getPlayerCount();
-    console.log(`  📊 Health check - Players online: ${playerCount}, Uptime: ${process.uptime().toFixed(1)}s`);
     res.status(200).json({
       status: 'healthy',
       uptime: process.uptime(),
       playerCount: playerCount,
+      reconnectCache: world.disconnectedPlayers.stats(),
       timestamp: Date.now()
     });
   });
@@ -46,11 +47,10 @@ function createApiRoutes(world) {
    */
   router.post('/player/join', (req, res) => {
     const { name } = req.body;
-    console.log(`  📝 Join request received - Name: "${name}", Current players: ${world.getPlayerCount()}`);
 
     // Validate input
     if (!name || typeof name !== 'string' || name.trim().length === 0) {
-      console.log(`  ❌ Join failed - Invalid name`);
+      logger.warn('http.join_failed', { reason: 'invalid name' });
       return res.status(400).json({
         success: false,
         error: 'Player name is required and must be a non-empty string'
@@ -71,13 +71,7 @@ function createApiRoutes(world) {
       player.health = 100;
       
       // Generate new spawn position
-      let x, y;
-      let attempts = 0;
-      do {
-        x = Math.floor(Math.random() * world.width);
-        y = Math.floor(Math.random() * world.height);
-        attempts++;
-      } while (world.getPlayerAtPosition(x, y) !== null && attempts < 10);
+      const { x, y } = world.spawnPosition();
       
       player.setPosition(x, y);
       
@@ -87,26 +81,20 @@ function createApiRoutes(world) {
       
       isReconnect = true;
       world.setRejoinMessage(name);
-      console.log(`  🔄 Player reconnected: "${name}" (ID: ${player.id}) at position (${x}, ${y}) - Total players: ${world.getPlayerCount()}`);
+      logger.info('http.rejoin', { name, id: player.id, x, y, players: world.getPlayerCount() });
     } else {
       // New player - generate fresh ID
       const playerId = `player_${Date.now()}_${Math.random().toString(36).substr(2, 9)}`;
       
       // Generate random spawn position
-      let x, y;
-      let attempts = 0;
-      do {
-        x = Math.floor(Math.random() * world.width);
-        y = Math.floor(Math.random() * world.height);
-        attempts++;
-      } while (world.getPlayerAtPosition(x, y) !== null && attempts < 10);
+      const { x, y } = world.spawnPosition();
 
       // Create new player
       player = new Player(playerId, name, x, y);
       world.addPlayer(player);
       
       world.setJoinMessage(name);
-      console.log(`  👤 Player joined: "${name}" (ID: ${playerId}) at position (${x}, ${y}) - Total players: ${world.getPlayerCount()}`);
+      logger.info('http.join', { name, id: playerId, x, y, players: world.getPlayerCount() });
     }
 
     res.status(201).json({
@@ -153,7 +141,7 @@ function createApiRoutes(world) {
     // Validate player exists
     const player = world.getPlayer(playerId);
     if (!player) {
-      console.log(`  ❌ Move failed - Player not found: ${playerId}`);
+      logger.warn('http.move_failed', { reason: 'player not found', id: playerId });
       return res.status(404).json({
         success: false,
         error: 'Player not found'
@@ -163,7 +151,7 @@ function createApiRoutes(world) {
     // Validate direction
     const validDirections = ['up', 'down', 'left', 'right'];
     if (!direction || !validDirections.includes(direction)) {
-      console.log(`  ❌ Move failed - Invalid direction: ${direction}`);
+      logger.warn('http.move_failed', { reason: 'invalid direction', id: playerId, direction });
       return res.status(400).json({
         success: false,
         error: 'Invalid direction. Must be: up, down, left, right'
@@ -194,7 +182,7 @@ function createApiRoutes(world) {
 
     // Check bounds
     if (!world.isValidPosition(newX, newY)) {
-      console.log(`  ❌ Move failed - Out of bounds: (${newX}, ${newY})`);
+      logger.warn('http.move_failed', { reason: 'out of bounds', id: playerId, x: newX, y: newY });
       return res.status(400).json({
         success: false,
         error: 'Move would go out of bounds'
@@ -226,7 +214,7 @@ function createApiRoutes(world) {
         world.setKillMessage(combatResult.finalWinnerName, combatResult.finalLoserName, 'player');
       }
       world.setLastCombat(combatResult);
-      console.log(`  ⚔️  Combat: "${player.name}" vs "${collidingPlayer.name}" - Winner: "${combatResult.finalWinnerName}" (${combatResult.finalScore})`);
+      logger.info('http.combat', { player: player.name, opponent: collidingPlayer.name, winner: combatResult.finalWinnerName, score: combatResult.finalScore });
     } else if (collidingMob) {
       collision = true;
       combatResult = CombatResolver.resolveBattle(player, collidingMob);
@@ -235,16 +223,16 @@ function createApiRoutes(world) {
         world.removePlayer(player.id);
         // Broadcast kill message (player killed by mob)
         world.setKillMessage(combatResult.finalWinnerName, combatResult.finalLoserName, 'player');
-        console.log(`  ⚔️  Combat: "${player.name}" vs "${collidingMob.name}" - Winner: "${combatResult.finalWinnerName}" (${combatResult.finalScore}) - PLAYER KILLED`);
+        logger.info('http.combat', { player: player.name, opponent: collidingMob.name, winner: combatResult.finalWinnerName, score: combatResult.finalScore });
       } else {
         world.removeMob(collidingMob.id);
         // Broadcast kill message (mob killed by player)
         world.setKillMessage(combatResult.finalWinnerName, combatResult.finalLoserName, 'mob');
-        console.log(`  ⚔️  Combat: "${player.name}" vs "${collidingMob.name}" - Winner: "${combatResult.finalWinnerName}" (${combatResult.finalScore}) - MOB KILLED`);
+        logger.info('http.combat', { player: player.name, opponent: collidingMob.name, winner: combatResult.finalWinnerName, score: combatResult.finalScore });
       }
       world.setLastCombat(combatResult);
-    } else {
-      console.log(`  🎮 ${player.name} moved ${direction} to (${newX}, ${newY})`);
+    } else if (logger.enabled('debug')) {
+      logger.debug('http.move', { name: player.name, direction, x: newX, y: newY });
     }
 
     res.status(200).json({
@@ -268,7 +256,7 @@ function createApiRoutes(world) {
     const { id } = req.body;
 
     if (!id) {
-      console.log(`  ❌ Leave failed - No player ID provided`);
+      logger.warn('http.leave_failed', { reason: 'no player id' });
       return res.status(400).json({
         success: false,
         error: 'Player ID is required'
@@ -279,14 +267,14 @@ function createApiRoutes(world) {
     const removed = world.removePlayer(id);
 
     if (!removed) {
-      console.log(`  ❌ Leave failed - Player not found: ${id}`);
+      logger.warn('http.leave_failed', { reason: 'player not found', id });
       return res.status(404).json({
         success: false,
         error: 'Player not found'
       });
     }
 
-    console.log(`  👋 Player left: "${player.name}" (ID: ${id}) - Total players: ${world.getPlayerCount()}`);
+    logger.info('http.leave', { name: player.name, id, players: world.getPlayerCount() });
 
     res.status(200).json({
       success: true,
@@ -0,0 +1,86 @@
+/**
+ * TCP Receive Buffer
+ *
+ * Fixed-capacity per-socket arena for TCP stream reassembly. Incoming
+ * chunks are copied in once; the frame parser reads bytes in place via
+ * byteAt()/toString() and consume()s whole frames, so decoding a packet
+ * allocates nothing. Unread bytes are compacted to the front only when
+ * the tail runs out of room.
+ */
+
+class RxBuffer {
+  /**
+   * @param {number} capacity - Bytes buffered per socket
+   */
+  constructor(capacity = 1024) {
+    this.buf = Buffer.allocUnsafe(capacity);
+    this.start = 0; // First unread byte
+    this.end = 0; // One past the last buffered byte
+  }
+
+  /**
+   * Number of unread bytes
+   */
+  get length() {
+    return this.end - this.start;
+  }
+
+  /**
+   * Copy as much of a chunk as fits
+   * @param {Buffer} data - Incoming chunk
+   * @param {number} offset - First byte of data to copy
+   * @returns {number} - Bytes copied (0 when full)
+   */
+  append(data, offset = 0) {
+    if (this.end === this.buf.length && this.start > 0) {
+      this.compact();
+    }
+    const room = this.buf.length - this.end;
+    const count = Math.min(room, data.length - offset);
+    if (count > 0) {
+      data.copy(this.buf, this.end, offset, offset + count);
+      this.end += count;
+    }
+    return count;
+  }
+
+  /**
+   * Read an unread byte without consuming it
+   * @param {number} index - Offset from the first unread byte
+   * @returns {number} - Byte value
+   */
+  byteAt(index) {
+    return this.buf[this.start + index];
+  }
+
+  /**
+   * Decode unread bytes as a string without consuming them
+   * @param {number} offset - Offset from the first unread byte
+   * @param {number} length - Byte count
+   * @returns {string} - Decoded text
+   */
+  toString(offset, length) {
+    const from = this.start + offset;
+    return this.buf.toString('utf8', from, from + length);
+  }
+
+  /**
+   * Drop bytes from the front (a parsed frame)
+   * @param {number} count - Bytes to drop
+   */
+  consume(count) {
+    this.start += count;
+    if (this.start >= this.end) {
+      this.start = 0;
+      this.end = 0;
+    }
+  }
+
+  compact() {
+    this.buf.copyWithin(0, this.start, this.end);
+    this.end -= this.start;
+    this.start = 0;
+  }
+}
+
+module.exports = RxBuffer;
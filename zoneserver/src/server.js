@@ -11,17 +11,34 @@ const World = require('./world');
 const Mob = require('./mob');
 const createApiRoutes = require('./routes/api');
 const TcpServer = require('./tcp_server');
+const Simulation = require('./simulation');
+const ZoneHost = require('./zone_host');
+const logger = require('./logger');
+const zoneOptions = require('./zone_options').fromEnv(); // World and Simulation settings
 
 const PORT = parseInt(process.env.PORT || '3000', 10);
 const TCP_PORT = parseInt(process.env.TCP_PORT || '6809', 10);
-
-// Initialize world
-const world = new World(40, 20);
+// Zone worker threads; 0 runs a single zone on the main event loop
+const ZONES = parseInt(process.env.ZONES || '0', 10);
+
+// Sharded mode: each zone's World and tick loop lives in its own worker
+const zoneHost = ZONES > 0 && process.env.NODE_ENV !== 'test'
+  ? new ZoneHost(TCP_PORT, { zones: ZONES, zone: zoneOptions })
+  : null;
+
+// Single zone: the world and its simulation live on this event loop
+// (sharded zones build their own inside the workers)
+let world = null;
+let simulation = null;
+if (!zoneHost) {
+  world = new World(zoneOptions.width, zoneOptions.height, zoneOptions);
+  simulation = new Simulation(world, zoneOptions);
+}
 
 // Spawn initial mobs for testing multi-player rendering
 function spawnMobs() {
-  world.respawnMobs(3);
-  console.log(`🎮 Spawned initial mobs`);
+  const mobs = world.respawnMobs(zoneOptions.minMobs, zoneOptions.hunters);
+  logger.info('world.respawn', { mobs: mobs.length, hunters: mobs.filter(m => m.isHunter).length });
 }
 
 // Create Express app
@@ -31,58 +48,46 @@ const app = express();
 app.use(cors());
 app.use(express.json());
 
-// Enhanced request logging
+// Request logging: one structured line per response, written when it
+// finishes. State polls are debug level and sampled; with logging below
+// the level nothing is measured or allocated per request.
 app.use((req, res, next) => {
-  const timestamp = new Date().toISOString();
-  const method = req.method.padEnd(6);
-  const path = req.path;
-
-  // Get client IP (handle proxies and direct connections)
-  const clientIp = req.headers['x-forwarded-for'] || req.connection.remoteAddress || 'unknown';
-  const ipOnly = clientIp.split(',')[0].trim();  // Get first IP if multiple
-
-  // Condensed logging for /state requests (they're frequent)
-  const isStateRequest = path === '/world/state' || path.includes('/world/state');
-
-  // Log request details
-  let logMsg = `[${timestamp}] ${method} ${path}`;
-
-  // Add body info for POST/PUT requests
-  if ((req.method === 'POST' || req.method === 'PUT') && req.body && Object.keys(req.body).length > 0) {
-    logMsg += ` | Body: ${JSON.stringify(req.body)}`;
-  }
-
-  // For state requests, use condensed format with client IP
-  if (isStateRequest) {
-    logMsg += ` [state] from ${ipOnly}`;
+  const isStateRequest = req.path === '/world/state' || req.path.includes('/world/state');
+  const level = isStateRequest ? 'debug' : 'info';
+  if (!logger.enabled(level)) {
+    return next();
   }
 
-  console.log(logMsg);
-
-  // Capture response status
-  const originalJson = res.json;
-  res.json = function (data) {
-    const statusCode = res.statusCode;
-    const statusColor = statusCode >= 400 ? '❌' : '✅';
-
-    // Condensed response logging for state requests
-    if (isStateRequest) {
-      console.log(`  ${statusColor} [${statusCode}]`);
-    } else {
-      console.log(`  ${statusColor} Response [${statusCode}]: ${JSON.stringify(data).substring(0, 100)}${JSON.stringify(data).length > 100 ? '...' : ''}`);
-    }
-    return originalJson.call(this, data);
-  };
+  const started = Date.now();
+  res.on('finish', () => {
+    // Get client IP (handle proxies and direct connections)
+    const clientIp = req.headers['x-forwarded-for'] || req.connection.remoteAddress || 'unknown';
+    logger.write(level, isStateRequest ? 'http.state' : 'http.request', {
+      method: req.method,
+      path: req.path,
+      status: res.statusCode,
+      ms: Date.now() - started,
+      ip: clientIp.split(',')[0].trim()  // Get first IP if multiple
+    });
+  });
 
   next();
 });
 
-// API routes
-app.use('/api', createApiRoutes(world));
+// API routes (served by zone 0 when sharded)
+if (zoneHost) {
+  app.use('/api', (req, res, next) => {
+    zoneHost.request(0, { method: req.method, url: req.url, query: req.query, body: req.body })
+      .then(reply => res.status(reply.status).json(reply.body))
+      .catch(next);
+  });
+} else {
+  app.use('/api', createApiRoutes(world));
+}
 
 // Error handling middleware
 app.use((err, req, res, next) => {
-  console.error('Error:', err);
+  logger.error('http.error', { method: req.method, path: req.path, error: err.message, stack: err.stack });
   res.status(500).json({
     success: false,
     error: 'Internal server error'
@@ -99,48 +104,46 @@ app.use((req, res) => {
 
 // Start server only if not in test environment
 let server;
-if (process.env.NODE_ENV !== 'test') {
+if (zoneHost) {
+  zoneHost.start().then(() => {
+    server = app.listen(PORT, () => {
+      logger.info('http.listen', { port: PORT, zones: ZONES, width: zoneOptions.width, height: zoneOptions.height, tickRate: zoneOptions.tickRate });
+    });
+  });
+
+  process.on('SIGTERM', () => {
+    logger.info('server.shutdown', { signal: 'SIGTERM' });
+    zoneHost.stop().then(() => process.exit(0));
+  });
+} else if (process.env.NODE_ENV !== 'test') {
   // Start TCP Server
   const tcpServer = new TcpServer(world, TCP_PORT);
   tcpServer.start();
 
+  // Subscribed TCP clients get their changes pushed at the end of each tick
+  simulation.onTick(() => tcpServer.pushUpdates());
+
   server = app.listen(PORT, () => {
-    console.log(`KillZone Server running on http://localhost:${PORT}`);
-    console.log(`World dimensions: 40x20`);
-    console.log(`API health check: GET http://localhost:${PORT}/api/health`);
+    logger.info('http.listen', { port: PORT, width: world.width, height: world.height });
 
     // Spawn mobs for testing
     spawnMobs();
 
-    // Server maintenance loop
-    setInterval(() => {
-      // Every 100 ticks: respawn mobs if needed
-      if (world.ticks % 100 === 0) {
-        const spawnedMobs = world.respawnMobs(3);
-        if (spawnedMobs.length > 0) {
-          const hunterInfo = spawnedMobs.some(m => m.isHunter) ? ' (including Hunter)' : '';
-          console.log(`  🎮 Respawned ${spawnedMobs.length} mobs${hunterInfo}`);
-        }
-      }
-
-      // Every 30 seconds: clean up inactive players (2 min timeout)
-      if (world.ticks % 600 === 0) {
-        const inactivePlayers = world.cleanupInactivePlayers(120000);
-        if (inactivePlayers.length > 0) {
-          console.log(`  🧹 Cleaned up ${inactivePlayers.length} inactive player(s): ${inactivePlayers.map(p => p.name).join(', ')}`);
-        }
-      }
-    }, 100);  // Check every 100ms
+    // Fixed-rate simulation: mob AI, message expiry, respawn (every 10s)
+    // and inactive-player cleanup (2 min idle deadline per player)
+    simulation.start();
+    logger.info('simulation.start', { tickRate: simulation.tickRate });
   });
 
   // Graceful shutdown
   process.on('SIGTERM', () => {
-    console.log('SIGTERM received, shutting down gracefully...');
+    logger.info('server.shutdown', { signal: 'SIGTERM' });
+    simulation.stop();
     server.close(() => {
-      console.log('Server closed');
+      logger.info('server.closed');
       process.exit(0);
     });
   });
 }
 
-module.exports = { app, world };
+module.exports = { app, world, simulation };
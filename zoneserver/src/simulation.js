@@ -0,0 +1,130 @@
+/**
+ * Fixed-Timestep Simulation Loop
+ *
+ * Owns world ticking: mob AI, kill-message expiry, mob respawn and
+ * inactive-player cleanup all advance here at a fixed rate, so server
+ * load depends on the tick rate rather than on how often clients poll.
+ * Timed work runs off the world's timer wheel (World.timers), so a tick
+ * only pays for the timers that are due.
+ * World.getState() is a read-only snapshot of the last completed tick.
+ */
+
+const logger = require('./logger');
+
+const DEFAULT_TICK_RATE = 10; // Hz
+
+class Simulation {
+  /**
+   * @param {World} world - World to simulate
+   * @param {Object} options - Loop configuration
+   * @param {number} options.tickRate - Ticks per second
+   * @param {number} options.minMobs - Mob population respawn keeps up
+   * @param {number} options.hunters - Hunter mobs among them
+   * @param {number} options.respawnIntervalMs - How often to top up mobs
+   * @param {number} options.inactiveTimeoutMs - Idle time before a player is dropped (default: the world's)
+   * @param {number} options.maxCatchUpTicks - Ticks run at most per timer callback
+   */
+  constructor(world, options = {}) {
+    this.world = world;
+    this.tickRate = options.tickRate || DEFAULT_TICK_RATE;
+    this.tickMs = 1000 / this.tickRate;
+    this.minMobs = options.minMobs !== undefined ? options.minMobs : 3;
+    this.hunters = options.hunters !== undefined ? options.hunters : 1;
+    this.maxCatchUpTicks = options.maxCatchUpTicks || 5;
+    this.tickListeners = [];
+    this.timer = null;
+    this.respawnTimer = null;
+    this.lastTime = 0;
+    this.accumulator = 0;
+
+    // World timers run in our ticks; ones already pending are stretched
+    world.setTickMs(this.tickMs);
+    if (options.inactiveTimeoutMs !== undefined) {
+      world.setInactiveTimeout(options.inactiveTimeoutMs);
+    }
+    this.respawnTicks = world.ticksFor(options.respawnIntervalMs || 10000);
+  }
+
+  /**
+   * Register a callback run after every completed tick
+   * @param {Function} listener - Called with the world tick count
+   */
+  onTick(listener) {
+    this.tickListeners.push(listener);
+  }
+
+  /**
+   * Start ticking on a timer, with mob respawn on the world's timer wheel
+   */
+  start() {
+    if (this.timer) {
+      return;
+    }
+    this.respawnTimer = this.world.timers.every(this.respawnTicks, () => this.respawn());
+    this.lastTime = Date.now();
+    this.accumulator = 0;
+    this.timer = setInterval(() => this.advance(Date.now()), this.tickMs);
+    if (this.timer.unref) {
+      this.timer.unref();
+    }
+  }
+
+  /**
+   * Stop ticking
+   */
+  stop() {
+    if (this.timer) {
+      clearInterval(this.timer);
+      this.timer = null;
+      this.world.timers.cancel(this.respawnTimer);
+      this.respawnTimer = null;
+    }
+  }
+
+  /**
+   * Run as many fixed steps as wall-clock time allows
+   * @param {number} now - Current time in ms
+   * @returns {number} - Number of ticks run
+   */
+  advance(now) {
+    this.accumulator += now - this.lastTime;
+    this.lastTime = now;
+
+    let ran = 0;
+    while (this.accumulator >= this.tickMs && ran < this.maxCatchUpTicks) {
+      this.step();
+      this.accumulator -= this.tickMs;
+      ran++;
+    }
+
+    // Drop backlog we could not catch up on rather than spiralling
+    if (this.accumulator >= this.tickMs) {
+      this.accumulator = 0;
+    }
+    return ran;
+  }
+
+  /**
+   * Advance the world by exactly one tick
+   */
+  step() {
+    const world = this.world;
+    world.tick();
+
+    for (const listener of this.tickListeners) {
+      listener(world.ticks);
+    }
+  }
+
+  /**
+   * Top the mob population back up (respawn timer)
+   */
+  respawn() {
+    const spawnedMobs = this.world.respawnMobs(this.minMobs, this.hunters);
+    if (spawnedMobs.length > 0) {
+      logger.info('world.respawn', { mobs: spawnedMobs.length, hunters: spawnedMobs.filter(m => m.isHunter).length });
+    }
+  }
+}
+
+module.exports = Simulation;
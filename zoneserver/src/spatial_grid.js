@@ -0,0 +1,315 @@
+/**
+ * Spatial Grid Index
+ *
+ * Uniform occupancy grid mapping world cells to the entities standing in
+ * them. World keeps it in sync on add/remove/setPosition so position
+ * lookups cost O(1) instead of a scan over every player and mob.
+ *
+ * Grid cells are stored in fixed-size square chunks, allocated when the
+ * first entity enters one and dropped when the last one leaves, so memory
+ * follows the populated area rather than the map size.
+ *
+ * The grid also keeps a count of empty cells per chunk (FreeCells) current
+ * as buckets fill and empty, so spawning can draw a uniformly random free
+ * cell directly instead of sampling and retrying.
+ */
+
+const FreeCells = require('./free_cells');
+
+const EMPTY = Object.freeze([]);
+const DEFAULT_CHUNK_SIZE = 16; // Grid cells per chunk edge
+
+class SpatialGrid {
+  /**
+   * @param {number} width - World width in cells
+   * @param {number} height - World height in cells
+   * @param {number} cellSize - Grid cell edge length in world cells
+   * @param {number} chunkSize - Chunk edge length in grid cells
+   */
+  constructor(width, height, cellSize = 1, chunkSize = DEFAULT_CHUNK_SIZE) {
+    this.width = width;
+    this.height = height;
+    this.cellSize = cellSize;
+    this.cols = Math.ceil(width / cellSize);
+    this.rows = Math.ceil(height / cellSize);
+    this.chunkSize = chunkSize;
+    this.chunkCols = Math.ceil(this.cols / chunkSize);
+    this.chunkRows = Math.ceil(this.rows / chunkSize);
+    this.chunks = new Array(this.chunkCols * this.chunkRows).fill(null); // { cells, used } or null
+    this.outside = []; // Entities parked off-grid (out of bounds)
+    this.entityCells = new Map(); // entity -> cell index (-1 for outside)
+    const capacities = [];
+    for (let ky = 0; ky < this.chunkRows; ky++) {
+      for (let kx = 0; kx < this.chunkCols; kx++) {
+        capacities.push(this.chunkWidth(kx) * this.chunkHeight(ky));
+      }
+    }
+    this.free = new FreeCells(capacities); // Cells with no entity, per chunk
+  }
+
+  /**
+   * Get the grid cell index for a position
+   * @param {number} x - X coordinate
+   * @param {number} y - Y coordinate
+   * @returns {number} - Cell index, or -1 if outside the grid
+   */
+  cellIndex(x, y) {
+    if (!(x >= 0 && x < this.width && y >= 0 && y < this.height)) {
+      return -1;
+    }
+    const cx = Math.floor(x / this.cellSize);
+    const cy = Math.floor(y / this.cellSize);
+    return cy * this.cols + cx;
+  }
+
+  /**
+   * Insert an entity at its current position
+   * @param {Object} entity - Entity with x/y coordinates
+   */
+  insert(entity) {
+    if (this.entityCells.has(entity)) {
+      this.update(entity);
+      return;
+    }
+    const index = this.cellIndex(entity.x, entity.y);
+    this.bucketFor(index, true).push(entity);
+    this.entityCells.set(entity, index);
+  }
+
+  /**
+   * Remove an entity from the grid
+   * @param {Object} entity - Entity to remove
+   * @returns {boolean} - True if the entity was indexed
+   */
+  remove(entity) {
+    const index = this.entityCells.get(entity);
+    if (index === undefined) {
+      return false;
+    }
+    this.detach(entity, index);
+    this.entityCells.delete(entity);
+    return true;
+  }
+
+  /**
+   * Re-bucket an entity after its coordinates changed
+   * @param {Object} entity - Entity whose x/y were updated
+   */
+  update(entity) {
+    const oldIndex = this.entityCells.get(entity);
+    if (oldIndex === undefined) {
+      return;
+    }
+    const newIndex = this.cellIndex(entity.x, entity.y);
+    if (newIndex === oldIndex) {
+      return;
+    }
+    this.detach(entity, oldIndex);
+    this.bucketFor(newIndex, true).push(entity);
+    this.entityCells.set(entity, newIndex);
+  }
+
+  /**
+   * Get all entities standing exactly at a position
+   * @param {number} x - X coordinate
+   * @param {number} y - Y coordinate
+   * @returns {Array} - Entities at (x, y); empty array if none
+   */
+  getAt(x, y) {
+    const bucket = this.bucketFor(this.cellIndex(x, y), false);
+    if (!bucket) {
+      return EMPTY;
+    }
+    if (this.cellSize === 1 && bucket !== this.outside) {
+      return bucket;
+    }
+    return bucket.filter(e => e.x === x && e.y === y);
+  }
+
+  /**
+   * Collect every entity inside a rectangle (inclusive bounds). Chunks
+   * that hold no entities are skipped without visiting their cells.
+   * @param {number} x0 - Left column
+   * @param {number} y0 - Top row
+   * @param {number} x1 - Right column
+   * @param {number} y1 - Bottom row
+   * @param {Array} out - Array the entities are appended to
+   * @returns {Array} - out
+   */
+  queryRect(x0, y0, x1, y1, out = []) {
+    const left = Math.max(0, x0);
+    const top = Math.max(0, y0);
+    const right = Math.min(this.width - 1, x1);
+    const bottom = Math.min(this.height - 1, y1);
+    if (left > right || top > bottom) {
+      return out;
+    }
+    const size = this.chunkSize;
+    const cx0 = Math.floor(left / this.cellSize);
+    const cx1 = Math.floor(right / this.cellSize);
+    const cy0 = Math.floor(top / this.cellSize);
+    const cy1 = Math.floor(bottom / this.cellSize);
+    const exact = this.cellSize === 1;
+
+    for (let ky = Math.floor(cy0 / size); ky <= Math.floor(cy1 / size); ky++) {
+      for (let kx = Math.floor(cx0 / size); kx <= Math.floor(cx1 / size); kx++) {
+        const chunk = this.chunks[ky * this.chunkCols + kx];
+        if (!chunk) {
+          continue;
+        }
+        // Overlap of the rectangle with this chunk, in chunk-local cells
+        const lx0 = Math.max(cx0 - kx * size, 0);
+        const lx1 = Math.min(cx1 - kx * size, size - 1);
+        const ly0 = Math.max(cy0 - ky * size, 0);
+        const ly1 = Math.min(cy1 - ky * size, size - 1);
+        for (let ly = ly0; ly <= ly1; ly++) {
+          for (let lx = lx0; lx <= lx1; lx++) {
+            const bucket = chunk.cells[ly * size + lx];
+            if (!bucket) {
+              continue;
+            }
+            for (const entity of bucket) {
+              if (exact ||
+                  (entity.x >= left && entity.x <= right && entity.y >= top && entity.y <= bottom)) {
+                out.push(entity);
+              }
+            }
+          }
+        }
+      }
+    }
+    return out;
+  }
+
+  /**
+   * Pick a uniformly random cell with no entity in it
+   * @param {Function} random - Returns a float in [0, 1)
+   * @returns {Object|null} - { x, y } of the cell's top-left corner, or
+   *   null if every cell is occupied
+   */
+  randomFreeCell(random = Math.random) {
+    if (this.free.total === 0) {
+      return null;
+    }
+    const { chunk: slot, rank } = this.free.find(Math.floor(random() * this.free.total));
+    const kx = slot % this.chunkCols;
+    const ky = (slot - kx) / this.chunkCols;
+    const width = this.chunkWidth(kx);
+    const chunk = this.chunks[slot];
+    let local = rank;
+    if (chunk) {
+      // Walk the chunk's cells to the rank-th empty one
+      let left = rank;
+      for (local = 0; ; local++) {
+        const offset = Math.floor(local / width) * this.chunkSize + (local % width);
+        if (!chunk.cells[offset] && left-- === 0) {
+          break;
+        }
+      }
+    }
+    const cx = kx * this.chunkSize + (local % width);
+    const cy = ky * this.chunkSize + Math.floor(local / width);
+    return { x: cx * this.cellSize, y: cy * this.cellSize };
+  }
+
+  /**
+   * Number of cells with no entity in them
+   * @returns {number}
+   */
+  freeCellCount() {
+    return this.free.total;
+  }
+
+  /**
+   * Number of chunks currently allocated
+   * @returns {number}
+   */
+  chunkCount() {
+    let count = 0;
+    for (const chunk of this.chunks) {
+      if (chunk) {
+        count++;
+      }
+    }
+    return count;
+  }
+
+  /**
+   * Drop every indexed entity
+   */
+  clear() {
+    this.chunks.fill(null);
+    this.outside = [];
+    this.entityCells.clear();
+    this.free.reset();
+  }
+
+  /**
+   * Grid cells across a chunk column (the last one may be partial)
+   */
+  chunkWidth(kx) {
+    return Math.min(this.chunkSize, this.cols - kx * this.chunkSize);
+  }
+
+  chunkHeight(ky) {
+    return Math.min(this.chunkSize, this.rows - ky * this.chunkSize);
+  }
+
+  chunkOf(index) {
+    const cx = index % this.cols;
+    const cy = (index - cx) / this.cols;
+    return Math.floor(cy / this.chunkSize) * this.chunkCols + Math.floor(cx / this.chunkSize);
+  }
+
+  offsetInChunk(index) {
+    const cx = index % this.cols;
+    const cy = (index - cx) / this.cols;
+    return (cy % this.chunkSize) * this.chunkSize + (cx % this.chunkSize);
+  }
+
+  bucketFor(index, create) {
+    if (index < 0) {
+      return this.outside;
+    }
+    const slot = this.chunkOf(index);
+    let chunk = this.chunks[slot];
+    if (!chunk) {
+      if (!create) {
+        return null;
+      }
+      chunk = { cells: new Array(this.chunkSize * this.chunkSize).fill(null), used: 0 };
+      this.chunks[slot] = chunk;
+    }
+    const offset = this.offsetInChunk(index);
+    let bucket = chunk.cells[offset];
+    if (!bucket && create) {
+      bucket = [];
+      chunk.cells[offset] = bucket;
+      chunk.used++; // Non-empty cells in the chunk
+      this.free.take(slot);
+    }
+    return bucket;
+  }
+
+  detach(entity, index) {
+    const bucket = this.bucketFor(index, false);
+    if (!bucket) {
+      return;
+    }
+    const pos = bucket.indexOf(entity);
+    if (pos !== -1) {
+      bucket.splice(pos, 1);
+    }
+    if (bucket.length === 0 && index >= 0) {
+      const slot = this.chunkOf(index);
+      const chunk = this.chunks[slot];
+      chunk.cells[this.offsetInChunk(index)] = null;
+      this.free.release(slot);
+      if (--chunk.used === 0) {
+        this.chunks[slot] = null;
+      }
+    }
+  }
+}
+
+module.exports = SpatialGrid;
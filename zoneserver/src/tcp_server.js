@@ -1,6 +1,34 @@
 const net = require('net');
 const Player = require('./player');
 const CombatResolver = require('./combat');
+const RxBuffer = require('./rx_buffer');
+const ViewHandles = require('./view_handles');
+const FrameEncoder = require('./frame_encoder');
+const logger = require('./logger');
+const { version: SERVER_VERSION } = require('../package.json');
+
+const RX_BUFFER_SIZE = 1024; // Per-socket reassembly capacity
+const MAX_FRAME_LEN = 64; // Largest client frame we accept (join is 33)
+
+// 0x04 request flags
+const DELTA_FLAG_FULL = 0x01; // Client has no baseline; send everything
+
+const VERSION_BYTES = Buffer.from(SERVER_VERSION); // Sent in every join response
+const TYPE_ME = 'M'.charCodeAt(0);
+const EMPTY_BYTES = Buffer.alloc(0);
+
+// 0x07 batched moves: direction nibbles 0-3, at most MAX_MOVE_BATCH per frame
+const MAX_MOVE_BATCH = 8;
+const BATCH_DIR_CHARS = ['u', 'd', 'l', 'r'].map(c => c.charCodeAt(0));
+const NO_MOVE = Object.freeze({ hadCollision: false, battleMsg: '', loserId: '' });
+
+// Interest management: clients that declare a viewport at join (0x08) only
+// hear about the nearest entities inside it
+const MAX_VIEW_ENTITIES = 65; // Own player plus the 64 others a client tracks
+
+// 0x08 join flags
+const JOIN_FLAG_WIDE = 0x01; // Positions are u16 little-endian, for maps over 256 cells
+const JOIN_FLAG_ZONE = 0x02; // A [Zone] byte follows the name (routed by the cluster front end)
 
 /**
  * TCP Server for KillZone
@@ -12,24 +40,36 @@ class TcpServer {
         this.port = port;
         this.server = net.createServer(this.handleConnection.bind(this));
         this.clients = new Set();
+        this.encoder = new FrameEncoder(); // Shared scratch for every response
+        this.batchDirs = new Array(MAX_MOVE_BATCH).fill(0); // Decoded 0x07 directions
+        this.killMsgText = null; // Last kill message encoded...
+        this.killMsgBytes = Buffer.alloc(0); // ...and its cached bytes
     }
 
     start() {
         this.server.listen(this.port, () => {
-            console.log(`KillZone TCP Server running on port ${this.port}`);
+            logger.info('tcp.listen', { port: this.port });
         });
     }
 
     handleConnection(socket) {
-        console.log(`TCP Client connected: ${socket.remoteAddress}`);
+        logger.info('tcp.connect', { address: socket.remoteAddress });
         this.clients.add(socket);
 
         socket.player = null; // Associated player object
-        socket.rxBuffer = Buffer.alloc(0); // TCP stream reassembly buffer
+        socket.deltaSynced = false; // Has this socket received a 0x04 snapshot?
+        socket.subscribed = false; // Server pushes 0x04 frames each tick when set
+        socket.pushTick = 0; // Tick of the last frame pushed to this socket
+        socket.view = null; // Declared viewport { width, height }; null sees the whole world
+        socket.wide = false; // Positions sent as u16 rather than u8
+        socket.viewX = 0; // Viewport centre, kept while the player is dead
+        socket.viewY = 0;
+        socket.known = new ViewHandles(); // Entities the viewport client holds, by its own handles
+        socket.rx = new RxBuffer(RX_BUFFER_SIZE); // TCP stream reassembly buffer
 
         socket.on('data', (data) => this.handleData(socket, data));
         socket.on('close', () => this.handleClose(socket));
-        socket.on('error', (err) => console.error(`Socket error: ${err.message}`));
+        socket.on('error', (err) => logger.warn('tcp.socket_error', { error: err.message }));
     }
 
     handleData(socket, data) {
@@ -37,95 +77,203 @@ class TcpServer {
             return;
         }
 
-        socket.rxBuffer = Buffer.concat([socket.rxBuffer, data]);
+        // Large chunks (many coalesced packets) are fed through in pieces
+        let offset = 0;
+        while (offset < data.length) {
+            const copied = socket.rx.append(data, offset);
+            if (copied === 0) {
+                // Buffer full of a frame that never completes
+                logger.warn('tcp.rx_overflow', { address: socket.remoteAddress });
+                socket.destroy();
+                return;
+            }
+            offset += copied;
+            if (!this.parseFrames(socket)) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * Decode and dispatch every complete frame in the socket's RX buffer.
+     * Frames are read in place and consumed; nothing is sliced or copied.
+     * @returns {boolean} - False if the socket was dropped
+     */
+    parseFrames(socket) {
+        const rx = socket.rx;
 
-        while (socket.rxBuffer.length > 0) {
-            const packetType = socket.rxBuffer[0];
+        while (rx.length > 0) {
+            const packetType = rx.byteAt(0);
             let packetLen = 0;
 
             // Packet formats:
             // 0x01 [NameLen] [Name...]
             // 0x02 [DirChar]
             // 0x03
+            // 0x04 [Flags] [AckTicksLow] [AckTicksHigh]
+            // 0x05 [On]
+            // 0x06 [Seq] [DirChar] [Flags] [AckTicksLow] [AckTicksHigh]
+            // 0x07 [Seq] [Count] [Flags] [AckTicksLow] [AckTicksHigh] [DirNibbles...]
+            // 0x08 [Flags] [ViewW] [ViewH] [NameLen] [Name...] ([Zone])
             if (packetType === 0x01) {
-                if (socket.rxBuffer.length < 2) {
-                    return;
+                if (rx.length < 2) {
+                    return true;
                 }
                 // Protocol guardrails: 1..31 byte names only.
-                if (socket.rxBuffer[1] === 0 || socket.rxBuffer[1] > 31) {
-                    console.log(`Invalid join name length: ${socket.rxBuffer[1]}`);
+                if (rx.byteAt(1) === 0 || rx.byteAt(1) > 31) {
+                    logger.warn('tcp.bad_packet', { reason: 'join name length', nameLen: rx.byteAt(1) });
                     socket.destroy();
-                    return;
+                    return false;
                 }
-                packetLen = 2 + socket.rxBuffer[1];
+                packetLen = 2 + rx.byteAt(1);
             } else if (packetType === 0x02) {
                 packetLen = 2;
             } else if (packetType === 0x03) {
                 packetLen = 1;
+            } else if (packetType === 0x04) {
+                packetLen = 4;
+            } else if (packetType === 0x05) {
+                packetLen = 2;
+            } else if (packetType === 0x06) {
+                packetLen = 6;
+            } else if (packetType === 0x07) {
+                if (rx.length < 3) {
+                    return true;
+                }
+                const count = rx.byteAt(2);
+                if (count === 0 || count > MAX_MOVE_BATCH) {
+                    logger.warn('tcp.bad_packet', { reason: 'move batch size', count });
+                    socket.destroy();
+                    return false;
+                }
+                packetLen = 6 + ((count + 1) >> 1);
+            } else if (packetType === 0x08) {
+                if (rx.length < 5) {
+                    return true;
+                }
+                const nameLen = rx.byteAt(4);
+                if (nameLen === 0 || nameLen > 31 || rx.byteAt(2) === 0 || rx.byteAt(3) === 0) {
+                    logger.warn('tcp.bad_packet', { reason: 'viewport join', viewW: rx.byteAt(2), viewH: rx.byteAt(3), nameLen });
+                    socket.destroy();
+                    return false;
+                }
+                packetLen = 5 + nameLen + ((rx.byteAt(1) & JOIN_FLAG_ZONE) ? 1 : 0);
             } else {
-                console.log(`Unknown packet type: ${packetType}`);
-                socket.rxBuffer = socket.rxBuffer.slice(1);
+                logger.warn('tcp.bad_packet', { reason: 'unknown type', type: packetType });
+                rx.consume(1);
                 continue;
             }
 
-            if (socket.rxBuffer.length < packetLen) {
-                return;
+            if (packetLen > MAX_FRAME_LEN) {
+                logger.warn('tcp.bad_packet', { reason: 'oversized frame', length: packetLen, address: socket.remoteAddress });
+                socket.destroy();
+                return false;
             }
 
-            const packet = socket.rxBuffer.slice(0, packetLen);
-            socket.rxBuffer = socket.rxBuffer.slice(packetLen);
+            if (rx.length < packetLen) {
+                return true;
+            }
 
             try {
                 switch (packetType) {
                     case 0x01: // Join
-                        this.handleJoin(socket, packet.slice(1));
+                        this.handleJoin(socket, rx.toString(2, rx.byteAt(1)));
                         break;
                     case 0x02: // Move
-                        this.handleMove(socket, packet.slice(1));
+                        this.handleMove(socket, rx.byteAt(1));
                         break;
                     case 0x03: // Get State
                         this.handleGetState(socket);
                         break;
+                    case 0x04: // Get Delta State
+                        this.handleGetDelta(socket, rx.byteAt(1), rx.byteAt(2) | (rx.byteAt(3) << 8));
+                        break;
+                    case 0x05: // Subscribe to pushed updates
+                        this.handleSubscribe(socket, rx.byteAt(1) !== 0);
+                        break;
+                    case 0x06: // Move and get delta state
+                        this.handleMoveWithDelta(socket, rx.byteAt(1), rx.byteAt(2), rx.byteAt(3), rx.byteAt(4) | (rx.byteAt(5) << 8));
+                        break;
+                    case 0x07: { // Batched moves and get delta state
+                        const count = rx.byteAt(2);
+                        for (let i = 0; i < count; i++) {
+                            // Two steps per byte, first step in the low nibble
+                            const nibble = (rx.byteAt(6 + (i >> 1)) >> ((i & 1) * 4)) & 0x0F;
+                            this.batchDirs[i] = nibble < BATCH_DIR_CHARS.length ? BATCH_DIR_CHARS[nibble] : 0;
+                        }
+                        this.handleMoveBatch(socket, rx.byteAt(1), count, rx.byteAt(3), rx.byteAt(4) | (rx.byteAt(5) << 8));
+                        break;
+                    }
+                    case 0x08: // Join with a viewport
+                        this.handleJoin(socket, rx.toString(5, rx.byteAt(4)),
+                            { width: rx.byteAt(2), height: rx.byteAt(3) }, (rx.byteAt(1) & JOIN_FLAG_WIDE) !== 0);
+                        break;
                     default:
                         break;
                 }
             } catch (e) {
-                console.error(`Error handling TCP data: ${e.message}`);
+                logger.error('tcp.error', { error: e.message });
+            }
+
+            rx.consume(packetLen);
+            if (socket.destroyed) {
+                return false;
             }
         }
+        return true;
     }
 
-    sendMoveResponse(socket, player, hadCollision, battleMsg, loserId = '') {
-        const safeMsg = (battleMsg || '').substring(0, 39);
-        const safeLoserId = (loserId || '').substring(0, 31);
-        const msgBuf = Buffer.from(safeMsg);
-        const loserBuf = Buffer.from(safeLoserId);
+    /**
+     * Find the zone a connection asked for in its first frame, without
+     * consuming anything. Used by the cluster front end to route sockets.
+     * @param {Buffer} buf - Bytes received so far
+     * @returns {number|null|undefined} - Zone number; null if the first
+     *   frame names no zone; undefined if more bytes are needed
+     */
+    static joinZone(buf) {
+        if (buf.length === 0) {
+            return undefined;
+        }
+        if (buf[0] !== 0x08) {
+            return null;
+        }
+        if (buf.length < 5) {
+            return undefined;
+        }
+        if (!(buf[1] & JOIN_FLAG_ZONE)) {
+            return null;
+        }
+        const zoneOffset = 5 + buf[4];
+        return buf.length > zoneOffset ? buf[zoneOffset] : undefined;
+    }
 
+    sendMoveResponse(socket, player, hadCollision, battleMsg, loserId = '', seq = null) {
         // 0x02 [X] [Y] [Health] [Collision] [MsgLen] [Msg...] [LoserIdLen] [LoserId...]
-        const resp = Buffer.alloc(6 + msgBuf.length + 1 + loserBuf.length);
-        let offset = 0;
-        resp.writeUInt8(0x02, offset++);
-        resp.writeUInt8(Math.floor(player.x), offset++);
-        resp.writeUInt8(Math.floor(player.y), offset++);
-        resp.writeUInt8(player.health, offset++);
-        resp.writeUInt8(hadCollision ? 1 : 0, offset++);
-        resp.writeUInt8(msgBuf.length, offset++);
-        msgBuf.copy(resp, offset);
-        offset += msgBuf.length;
-        resp.writeUInt8(loserBuf.length, offset++);
-        loserBuf.copy(resp, offset);
-
-        socket.write(resp);
+        // Sequenced moves (0x06) echo the client's sequence number:
+        // 0x06 [Seq] [X] [Y] ...
+        const enc = this.encoder.begin();
+        if (seq === null) {
+            enc.u8(0x02);
+        } else {
+            enc.u8(0x06).u8(seq);
+        }
+        const frame = this.writePosition(enc, socket, player.x, player.y)
+            .u8(player.health)
+            .u8(hadCollision ? 1 : 0)
+            .lenString(battleMsg, 39)
+            .lenString(loserId, 31)
+            .finish();
+
+        socket.write(frame);
     }
 
-    handleJoin(socket, data) {
-        if (data.length < 1) return;
-        const nameLen = data[0];
-        if (data.length < 1 + nameLen) return;
-
-        const name = data.slice(1, 1 + nameLen).toString();
-        console.log(`TCP Join Request: ${name}`);
-
+    /**
+     * @param {string} name - Player name
+     * @param {Object|null} view - Viewport { width, height } the client
+     *   draws, or null to receive the whole world
+     * @param {boolean} wide - Send positions as u16 (0x08 joins only)
+     */
+    handleJoin(socket, name, view = null, wide = false) {
         // Check if previously disconnected
         const disconnectedPlayer = this.world.getDisconnectedPlayer(name);
         let player;
@@ -136,61 +284,60 @@ class TcpServer {
             player.health = 100;
 
             // New spawn pos
-            let x, y;
-            let attempts = 0;
-            do {
-                x = Math.floor(Math.random() * this.world.width);
-                y = Math.floor(Math.random() * this.world.height);
-                attempts++;
-            } while (this.world.getPlayerAtPosition(x, y) !== null && attempts < 10);
-
+            const { x, y } = this.world.spawnPosition();
             player.setPosition(x, y);
             this.world.removeDisconnectedPlayer(name);
             this.world.addPlayer(player);
             this.world.setRejoinMessage(name);
-            console.log(`  🔄 TCP Rejoin: ${name}`);
+            logger.info('tcp.rejoin', { name, id: player.id, x, y });
         } else {
             const playerId = `player_${Date.now()}_${Math.random().toString(36).substr(2, 9)}`;
-            let x, y;
-            let attempts = 0;
-            do {
-                x = Math.floor(Math.random() * this.world.width);
-                y = Math.floor(Math.random() * this.world.height);
-                attempts++;
-            } while (this.world.getPlayerAtPosition(x, y) !== null && attempts < 10);
-
+            const { x, y } = this.world.spawnPosition();
             player = new Player(playerId, name, x, y);
             this.world.addPlayer(player);
             this.world.setJoinMessage(name);
-            console.log(`  👤 TCP Join: ${name}`);
+            logger.info('tcp.join', { name, id: player.id, x, y });
         }
 
         socket.player = player;
+        socket.deltaSynced = false; // Rejoined clients start from a fresh snapshot
+        socket.subscribed = false; // ...and re-subscribe once they have joined
+        socket.view = view;
+        socket.wide = wide;
+        socket.known = new ViewHandles();
 
         // Response: 0x01 [ID_LEN] [ID] [X] [Y] [Health] [VER_LEN] [VERSION]
-        const pkg = require('../package.json');
-        const verBuf = Buffer.from(pkg.version);
-        const idBuf = Buffer.from(player.id);
-        const resp = Buffer.alloc(1 + 1 + idBuf.length + 1 + 1 + 1 + 1 + verBuf.length);
-        let offset = 0;
-        resp.writeUInt8(0x01, offset++);
-        resp.writeUInt8(idBuf.length, offset++);
-        idBuf.copy(resp, offset); offset += idBuf.length;
-        resp.writeUInt8(Math.floor(player.x), offset++);
-        resp.writeUInt8(Math.floor(player.y), offset++);
-        resp.writeUInt8(player.health, offset++);
-        resp.writeUInt8(verBuf.length, offset++);
-        verBuf.copy(resp, offset); offset += verBuf.length;
-
-        socket.write(resp);
+        // Wide: 0x01 [ID_LEN] [ID] [X16] [Y16] [Health] [Width16] [Height16] [VER_LEN] [VERSION]
+        const enc = this.encoder.begin()
+            .u8(0x01)
+            .lenString(player.id, 255);
+        this.writePosition(enc, socket, player.x, player.y)
+            .u8(player.health);
+        if (wide) {
+            enc.u16(this.world.width).u16(this.world.height);
+        }
+        const frame = enc.lenBytes(VERSION_BYTES).finish();
+
+        socket.write(frame);
     }
 
-    handleMove(socket, data) {
+    handleMove(socket, dirByte, seq = null) {
         if (!socket.player) return;
-        if (data.length < 1) return;
 
         const activePlayer = socket.player;
-        const dirChar = String.fromCharCode(data[0]);
+        const result = this.applyMove(socket, dirByte);
+        this.sendMoveResponse(socket, activePlayer, result.hadCollision, result.battleMsg, result.loserId, seq);
+    }
+
+    /**
+     * Apply one step for the socket's player, resolving any combat
+     * @param {Object} socket - Client socket with a live player
+     * @param {number} dirByte - Direction char code (u/d/l/r)
+     * @returns {Object} - { hadCollision, battleMsg, loserId }
+     */
+    applyMove(socket, dirByte) {
+        const activePlayer = socket.player;
+        const dirChar = String.fromCharCode(dirByte);
         let direction = null; // 'up', 'down', 'left', 'right'
 
         // Simple char mapping
@@ -201,8 +348,7 @@ class TcpServer {
 
         if (!direction) {
             // Keep protocol in sync even for malformed packets.
-            this.sendMoveResponse(socket, activePlayer, false, '', '');
-            return;
+            return NO_MOVE;
         }
 
         this.world.updatePlayerActivity(activePlayer.id);
@@ -223,8 +369,7 @@ class TcpServer {
         }
 
         if (!this.world.isValidPosition(newX, newY)) {
-            this.sendMoveResponse(socket, activePlayer, false, '', '');
-            return;
+            return NO_MOVE;
         }
 
         // Check collisions
@@ -234,7 +379,7 @@ class TcpServer {
         if (collidingPlayer) {
             hadCollision = true;
             const result = CombatResolver.resolveBattle(activePlayer, collidingPlayer);
-            console.log(`  ⚔️  TCP Combat: "${activePlayer.name}" vs "${collidingPlayer.name}" - Winner: "${result.finalWinnerName}"`);
+            logger.info('tcp.combat', { player: activePlayer.name, opponent: collidingPlayer.name, winner: result.finalWinnerName });
             battleMsg = `${result.finalWinnerName} defeats ${result.finalLoserName}!`;
             loserId = result.finalLoserId || '';
             if (result.finalLoserId === activePlayer.id) {
@@ -249,7 +394,7 @@ class TcpServer {
         } else if (collidingMob) {
             hadCollision = true;
             const result = CombatResolver.resolveBattle(activePlayer, collidingMob);
-            console.log(`  ⚔️  TCP Combat: "${activePlayer.name}" vs "${collidingMob.name}" - Winner: "${result.finalWinnerName}"`);
+            logger.info('tcp.combat', { player: activePlayer.name, opponent: collidingMob.name, winner: result.finalWinnerName });
             battleMsg = `${result.finalWinnerName} defeats ${result.finalLoserName}!`;
             loserId = result.finalLoserId || '';
             if (result.finalLoserId === activePlayer.id) {
@@ -263,68 +408,378 @@ class TcpServer {
         } else {
             // Move
             activePlayer.setPosition(newX, newY);
-            console.log(`  🎮 TCP Move: ${activePlayer.name} to (${newX}, ${newY})`);
+            if (logger.enabled('debug')) {
+                logger.debug('tcp.move', { name: activePlayer.name, x: newX, y: newY });
+            }
         }
 
-        this.sendMoveResponse(socket, activePlayer, hadCollision, battleMsg, loserId);
-
         // Prevent dead sockets from continuing to move as ghost clients.
         if (loserId && loserId === activePlayer.id) {
             socket.player = null;
         }
+
+        return { hadCollision, battleMsg, loserId };
     }
 
-    handleGetState(socket) {
-        // Trigger world update (tick, mob movement, etc)
-        const worldState = this.world.getState();
-        const ticks = worldState.ticks % 65536; // Limit to 16-bit
+    /**
+     * Apply a burst of queued moves in order, then reply with every step's
+     * result in one 0x07 frame followed by a delta (0x04) from the
+     * client's acknowledged tick. Steps stop early if the player dies.
+     * @param {number} count - Steps decoded into this.batchDirs
+     */
+    handleMoveBatch(socket, seq, count, flags, ack) {
+        if (!socket.player) return;
 
-        const players = Array.from(this.world.players.values());
-        const mobs = Array.from(this.world.mobs.values());
-        const all = [...players, ...mobs];
+        const activePlayer = socket.player;
+        const steps = [];
+        for (let i = 0; i < count && socket.player; i++) {
+            const result = this.applyMove(socket, this.batchDirs[i]);
+            steps.push({ x: activePlayer.x, y: activePlayer.y, health: activePlayer.health, ...result });
+        }
 
-        const count = Math.min(all.length, 255);
+        // 0x07 [Seq] [Count] then per step:
+        // [X] [Y] [Health] [Collision] [MsgLen] [Msg...] [LoserIdLen] [LoserId...]
+        const enc = this.encoder.begin()
+            .u8(0x07)
+            .u8(seq)
+            .u8(steps.length);
+        for (const step of steps) {
+            this.writePosition(enc, socket, step.x, step.y)
+                .u8(step.health)
+                .u8(step.hadCollision ? 1 : 0)
+                .lenString(step.battleMsg, 39)
+                .lenString(step.loserId, 31);
+        }
+        const frame = enc.finish();
+
+        socket.cork();
+        socket.write(frame);
+        this.handleGetDelta(socket, flags, ack);
+        socket.uncork();
 
-        // Get any pending combat message (e.g., from hunter attacks)
-        let combatMsg = worldState.lastKillMessage || '';
-        if (combatMsg.length > 39) {
-            combatMsg = combatMsg.substring(0, 39);
+        if (socket.subscribed) {
+            socket.pushTick = this.world.ticks;
         }
-        const msgBuf = Buffer.from(combatMsg);
+    }
+
+    /**
+     * Move, then reply with the sequenced move result (0x06) immediately
+     * followed by a delta (0x04) from the client's acknowledged tick, so a
+     * step and the world's reaction cost one round trip. The echoed
+     * sequence number lets a predicting client match the authoritative
+     * position to the step it guessed.
+     */
+    handleMoveWithDelta(socket, seq, dirByte, flags, ack) {
+        if (!socket.player) return;
+
+        socket.cork();
+        this.handleMove(socket, dirByte, seq);
+        this.handleGetDelta(socket, flags, ack);
+        socket.uncork();
+
+        // The reply brought a subscriber up to date; don't push it again
+        if (socket.subscribed) {
+            socket.pushTick = this.world.ticks;
+        }
+    }
+
+    handleGetState(socket) {
+        // Snapshot of the last simulation tick (ticking happens in Simulation)
+        const world = this.world;
+        const visible = socket.view ? this.visibleEntities(socket) : null;
+        const count = visible ? visible.length : Math.min(world.players.size + world.mobs.size, 255);
 
         // Format: 0x03 [Count] [TicksLow] [TicksHigh] [MsgLen] [Msg...] [Entity1: Type X Y] [Entity2: ...]
-        const buf = Buffer.alloc(5 + msgBuf.length + count * 3);
-        let offset = 0;
-        buf.writeUInt8(0x03, offset++);
-        buf.writeUInt8(count, offset++);
-        buf.writeUInt8(ticks & 0xFF, offset++);        // Ticks low byte
-        buf.writeUInt8((ticks >> 8) & 0xFF, offset++); // Ticks high byte
-        buf.writeUInt8(msgBuf.length, offset++);       // Message length
-        msgBuf.copy(buf, offset); offset += msgBuf.length;
-
-        for (let i = 0; i < count; i++) {
-            const ent = all[i];
-            let typeChar = 'O';
+        const enc = this.encoder.begin()
+            .u8(0x03)
+            .u8(count)
+            .u16(world.ticks)
+            .lenBytes(this.killMessageBytes()); // Pending combat message (e.g., from hunter attacks)
+
+        let written = 0;
+        for (const entities of visible ? [visible] : [world.players, world.mobs]) {
+            for (const ent of entities.values()) {
+                if (written === count) break;
+                enc.u8(this.entityTypeChar(socket, ent).charCodeAt(0));
+                this.writePosition(enc, socket, ent.x, ent.y);
+                written++;
+            }
+        }
+
+        socket.write(enc.finish());
+    }
+
+    /**
+     * Encoded kill message (max 39 chars), re-encoded only when it changes
+     * @returns {Buffer} - Message bytes
+     */
+    killMessageBytes() {
+        const text = this.world.lastKillMessage || '';
+        if (text !== this.killMsgText) {
+            this.killMsgText = text;
+            this.killMsgBytes = Buffer.from(text.substring(0, 39));
+        }
+        return this.killMsgBytes;
+    }
+
+    /**
+     * Append a position in the socket's coordinate width
+     * @returns {FrameEncoder} - enc, for chaining
+     */
+    writePosition(enc, socket, x, y) {
+        if (socket.wide) {
+            return enc.u16(Math.floor(x)).u16(Math.floor(y));
+        }
+        return enc.u8(Math.floor(x)).u8(Math.floor(y));
+    }
+
+    entityTypeChar(socket, ent) {
+        if (ent.type === 'player') {
+            return (socket.player && ent.id === socket.player.id) ? 'M' : 'P';
+        }
+        return ent.isHunter ? 'H' : 'E';
+    }
+
+    handleGetDelta(socket, flags, ack) {
+        const current = this.world.ticks;
+
+        // Widen the 16-bit acknowledged tick back to a full tick count
+        const baseline = current - (((current & 0xFFFF) - ack) & 0xFFFF);
+        const forceFull = (flags & DELTA_FLAG_FULL) !== 0 || !socket.deltaSynced;
+
+        if (socket.view) {
+            socket.write(this.encodeViewDelta(socket, baseline, forceFull, false));
+        } else {
+            socket.write(this.frameFor(socket, this.encodeDelta(baseline, forceFull, false)));
+        }
+        socket.deltaSynced = true;
+    }
+
+    /**
+     * Encode a recipient-neutral 0x04 delta frame. Every player is encoded
+     * as 'P'; frameFor() patches the recipient's own entry to 'M'.
+     * @param {number} baseline - Last tick the recipients have applied
+     * @param {boolean} forceFull - Send a full snapshot regardless of baseline
+     * @param {boolean} skipEmpty - Return null instead of an empty delta
+     * @returns {Object|null} - { frame, typeOffsets: Map(player -> offset) }
+     */
+    encodeDelta(baseline, forceFull, skipEmpty) {
+        const world = this.world;
+        const current = world.ticks;
+        let full = forceFull || !world.delta.canDeltaFrom(baseline, current);
+
+        let removed = [];
+        let upserts = [];
+        if (!full) {
+            removed = world.delta.removedSince(baseline);
+            upserts = this.collectChanged(baseline);
+            if (removed.length > 255 || upserts.length > 255) {
+                full = true; // Too much churn for one delta; resync instead
+            }
+        }
+        if (full) {
+            removed = [];
+            upserts = this.collectChanged(-1).slice(0, 255);
+        }
+
+        const sendMsg = full || world.lastKillMessageTick > baseline;
+        const msgBytes = sendMsg ? this.killMessageBytes() : EMPTY_BYTES;
+
+        if (skipEmpty && !full && removed.length === 0 && upserts.length === 0 && msgBytes.length === 0) {
+            return null;
+        }
+
+        // Format: 0x04 [Flags] [TicksLow] [TicksHigh] [MsgLen] [Msg...]
+        //         [RemovedCount] [Handle...] [UpsertCount] [Handle Type X Y]...
+        const enc = this.encoder.begin()
+            .u8(0x04)
+            .u8(full ? DELTA_FLAG_FULL : 0)
+            .u16(current)
+            .lenBytes(msgBytes)
+            .u8(removed.length);
+        for (const handle of removed) {
+            enc.u8(handle);
+        }
+
+        const typeOffsets = new Map();
+        enc.u8(upserts.length);
+        for (const ent of upserts) {
+            enc.u8(ent.handle);
             if (ent.type === 'player') {
-                typeChar = (socket.player && ent.id === socket.player.id) ? 'M' : 'P';
-            } else if (ent.isHunter) {
-                typeChar = 'H';
+                typeOffsets.set(ent, enc.offset);
+                enc.u8('P'.charCodeAt(0));
             } else {
-                typeChar = 'E';
+                enc.u8((ent.isHunter ? 'H' : 'E').charCodeAt(0));
             }
+            enc.u8(Math.floor(ent.x)).u8(Math.floor(ent.y));
+        }
+
+        return { frame: enc.finish(), typeOffsets };
+    }
+
+    /**
+     * Tailor a shared delta frame to one recipient. Sockets whose own
+     * player is not in the frame get the shared buffer as-is.
+     * @returns {Buffer} - Frame to write
+     */
+    frameFor(socket, encoded) {
+        const offset = socket.player ? encoded.typeOffsets.get(socket.player) : undefined;
+        if (offset === undefined) {
+            return encoded.frame;
+        }
+        const copy = Buffer.allocUnsafe(encoded.frame.length);
+        encoded.frame.copy(copy);
+        copy[offset] = TYPE_ME;
+        return copy;
+    }
+
+    /**
+     * Entities inside a socket's viewport, nearest first, capped at
+     * MAX_VIEW_ENTITIES. The viewport is centred on the player and clamped
+     * to the world edges, so a viewport as big as the world sees all of it.
+     * @returns {Array} - Visible entities
+     */
+    visibleEntities(socket) {
+        const world = this.world;
+        const { width, height } = socket.view;
+        if (socket.player) {
+            socket.viewX = Math.floor(socket.player.x);
+            socket.viewY = Math.floor(socket.player.y);
+        }
+        const cx = socket.viewX;
+        const cy = socket.viewY;
+        const x0 = Math.max(0, Math.min(cx - (width >> 1), world.width - width));
+        const y0 = Math.max(0, Math.min(cy - (height >> 1), world.height - height));
+
+        const visible = world.grid.queryRect(x0, y0, x0 + width - 1, y0 + height - 1);
+        // Nearest first, so the cap (and a client that truncates a long
+        // snapshot) drops the farthest entities
+        const dist = ent => (ent.x - cx) * (ent.x - cx) + (ent.y - cy) * (ent.y - cy);
+        visible.sort((a, b) => dist(a) - dist(b));
+        if (visible.length > MAX_VIEW_ENTITIES) {
+            visible.length = MAX_VIEW_ENTITIES;
+        }
+        return visible;
+    }
+
+    /**
+     * Encode a 0x04 delta for a viewport client. Removals and upserts are
+     * worked out against the entities the client was last sent (socket.known),
+     * so entities leaving the view are removed and ones entering it are sent
+     * even if they did not move. Handles come from socket.known rather than
+     * the world, so a busy zone never runs a viewport client out of them.
+     * @param {number} baseline - Last tick the client has applied
+     * @param {boolean} forceFull - Send a full snapshot of the view
+     * @param {boolean} skipEmpty - Return null instead of an empty delta
+     * @returns {Buffer|null} - Frame to write
+     */
+    encodeViewDelta(socket, baseline, forceFull, skipEmpty) {
+        const world = this.world;
+        const known = socket.known;
+        const visible = this.visibleEntities(socket);
+
+        let removed = [];
+        if (forceFull) {
+            known.clear();
+        } else {
+            removed = known.retain(new Set(visible));
+        }
+        const upserts = forceFull
+            ? visible
+            : visible.filter(ent => !known.has(ent) || ent.changedTick > baseline);
+
+        const sendMsg = forceFull || world.lastKillMessageTick > baseline;
+        const msgBytes = sendMsg ? this.killMessageBytes() : EMPTY_BYTES;
+
+        if (skipEmpty && !forceFull && removed.length === 0 && upserts.length === 0 && msgBytes.length === 0) {
+            return null;
+        }
+
+        // Same layout as encodeDelta(), with the recipient's type chars and
+        // coordinate width
+        const enc = this.encoder.begin()
+            .u8(0x04)
+            .u8(forceFull ? DELTA_FLAG_FULL : 0)
+            .u16(world.ticks)
+            .lenBytes(msgBytes)
+            .u8(removed.length);
+        for (const handle of removed) {
+            enc.u8(handle);
+        }
+        enc.u8(upserts.length);
+        for (const ent of upserts) {
+            enc.u8(known.handleOf(ent))
+                .u8(this.entityTypeChar(socket, ent).charCodeAt(0));
+            this.writePosition(enc, socket, ent.x, ent.y);
+        }
+        return enc.finish();
+    }
+
+    handleSubscribe(socket, on) {
+        if (!on) {
+            socket.subscribed = false;
+            return;
+        }
 
-            buf.writeUInt8(typeChar.charCodeAt(0), offset++);
-            buf.writeUInt8(Math.floor(ent.x), offset++);
-            buf.writeUInt8(Math.floor(ent.y), offset++);
+        // Start the subscription with a full snapshot as the push baseline
+        socket.subscribed = true;
+        socket.pushTick = this.world.ticks;
+        if (socket.view) {
+            socket.write(this.encodeViewDelta(socket, socket.pushTick, true, false));
+        } else {
+            socket.write(this.frameFor(socket, this.encodeDelta(socket.pushTick, true, false)));
         }
+    }
 
-        socket.write(buf);
+    /**
+     * Push a delta frame to every subscribed socket whose view changed.
+     * Called by the simulation loop at the end of each tick. Sockets that
+     * share a baseline (normally all of them) share one encoded frame;
+     * viewport clients get frames filtered to their own view.
+     */
+    pushUpdates() {
+        const current = this.world.ticks;
+        const frames = new Map(); // pushTick -> encoded frame (or null)
+        for (const socket of this.clients) {
+            if (!socket.subscribed || socket.destroyed) {
+                continue;
+            }
+            if (socket.view) {
+                const frame = this.encodeViewDelta(socket, socket.pushTick, false, true);
+                socket.pushTick = current;
+                if (frame) {
+                    socket.write(frame);
+                }
+                continue;
+            }
+            let encoded = frames.get(socket.pushTick);
+            if (encoded === undefined) {
+                encoded = this.encodeDelta(socket.pushTick, false, true);
+                frames.set(socket.pushTick, encoded);
+            }
+            socket.pushTick = current;
+            if (encoded) {
+                socket.write(this.frameFor(socket, encoded));
+            }
+        }
+    }
+
+    collectChanged(baseline) {
+        const changed = [];
+        for (const entities of [this.world.players, this.world.mobs]) {
+            for (const ent of entities.values()) {
+                if (ent.handle && ent.changedTick > baseline) {
+                    changed.push(ent);
+                }
+            }
+        }
+        return changed;
     }
 
     handleClose(socket) {
         this.clients.delete(socket);
         if (socket.player) {
-            console.log(`TCP Client Disconnected: ${socket.player.name}`);
+            logger.info('tcp.disconnect', { name: socket.player.name });
             this.world.removePlayer(socket.player.id);
         }
     }
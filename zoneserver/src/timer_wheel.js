@@ -0,0 +1,195 @@
+/**
+ * Hierarchical Timer Wheel
+ *
+ * Schedules callbacks on world ticks. Level 0 has one slot per tick for
+ * the next 64 ticks; each level above covers 64 times the span of the one
+ * below with slots 64 times as wide. When a lower level wraps, the next
+ * slot up is emptied and its timers re-filed closer to the front, so a
+ * timer moves down at most once per level before it fires.
+ *
+ * Scheduling, cancelling and rescheduling cost O(1), and a tick only
+ * touches the timers that fire (plus the occasional cascade), so the
+ * cost of expiry follows what expires, not how many timers are pending.
+ * Four levels cover 64^4 ticks (19 days at 10 Hz); later deadlines wait
+ * in the top level and are re-filed until they come into range.
+ */
+
+const SLOT_BITS = 6;
+const SLOTS = 1 << SLOT_BITS; // Slots per level
+const SLOT_MASK = SLOTS - 1;
+const LEVELS = 4;
+const MAX_SPAN = Math.pow(SLOTS, LEVELS); // Ticks the wheel can hold
+
+class TimerWheel {
+  /**
+   * @param {number} currentTick - Tick the wheel starts at
+   */
+  constructor(currentTick = 0) {
+    this.currentTick = currentTick;
+    this.levels = [];
+    for (let level = 0; level < LEVELS; level++) {
+      const slots = [];
+      for (let i = 0; i < SLOTS; i++) {
+        slots.push(new Set());
+      }
+      this.levels.push(slots);
+    }
+    this.size = 0;
+  }
+
+  /**
+   * Run a callback after a number of ticks
+   * @param {number} delayTicks - Ticks from now (at least 1)
+   * @param {Function} callback - Called with the tick it fires on
+   * @param {number} intervalTicks - Repeat this often after the first run (0: once)
+   * @returns {Object} - Timer handle for cancel()/reschedule()
+   */
+  schedule(delayTicks, callback, intervalTicks = 0) {
+    const timer = { deadline: 0, callback, interval: intervalTicks, slot: null };
+    this.file(timer, this.currentTick + Math.max(1, Math.ceil(delayTicks)));
+    return timer;
+  }
+
+  /**
+   * Run a callback every `intervalTicks` ticks, starting one interval from now
+   */
+  every(intervalTicks, callback) {
+    return this.schedule(intervalTicks, callback, Math.max(1, intervalTicks));
+  }
+
+  /**
+   * Move a pending (or already fired) timer to a new delay from now
+   * @param {Object} timer - Handle from schedule()
+   * @param {number} delayTicks - Ticks from now (at least 1)
+   */
+  reschedule(timer, delayTicks) {
+    this.cancel(timer);
+    this.file(timer, this.currentTick + Math.max(1, Math.ceil(delayTicks)));
+  }
+
+  /**
+   * Stop a timer from firing
+   * @param {Object} timer - Handle from schedule()
+   * @returns {boolean} - Whether it was still pending
+   */
+  cancel(timer) {
+    if (!timer || !timer.slot) {
+      return false;
+    }
+    timer.slot.delete(timer);
+    timer.slot = null;
+    this.size--;
+    return true;
+  }
+
+  /**
+   * Fire everything due up to and including a tick
+   * @param {number} tick - Tick to advance to
+   * @returns {number} - Timers fired
+   */
+  advance(tick) {
+    let fired = 0;
+    while (this.currentTick < tick) {
+      this.currentTick++;
+      fired += this.step();
+    }
+    return fired;
+  }
+
+  /**
+   * Stretch every pending timer's remaining delay (and repeat interval)
+   * by a factor, e.g. when the length of a tick changes
+   * @param {number} factor - New ticks per old tick
+   */
+  rescale(factor) {
+    const pending = [];
+    for (const slots of this.levels) {
+      for (const slot of slots) {
+        pending.push(...slot);
+      }
+    }
+    this.clear();
+    for (const timer of pending) {
+      if (timer.interval > 0) {
+        timer.interval = Math.max(1, Math.round(timer.interval * factor));
+      }
+      this.file(timer, this.currentTick + Math.max(1, Math.ceil((timer.deadline - this.currentTick) * factor)));
+    }
+  }
+
+  /**
+   * Drop every pending timer
+   */
+  clear() {
+    for (const slots of this.levels) {
+      for (const slot of slots) {
+        for (const timer of slot) {
+          timer.slot = null;
+        }
+        slot.clear();
+      }
+    }
+    this.size = 0;
+  }
+
+  step() {
+    const now = this.currentTick;
+
+    // Level n wraps every 64^n ticks; pull its next slot down a level
+    for (let level = 1; level < LEVELS; level++) {
+      if ((now & (Math.pow(SLOTS, level) - 1)) !== 0) {
+        break;
+      }
+      this.cascade(level, Math.floor(now / Math.pow(SLOTS, level)) & SLOT_MASK);
+    }
+
+    const slot = this.levels[0][now & SLOT_MASK];
+    if (slot.size === 0) {
+      return 0;
+    }
+    const due = [...slot];
+    slot.clear();
+    this.size -= due.length;
+    for (const timer of due) {
+      timer.slot = null;
+      if (timer.interval > 0) {
+        this.file(timer, now + timer.interval);
+      }
+      timer.callback(now);
+    }
+    return due.length;
+  }
+
+  cascade(level, index) {
+    const slot = this.levels[level][index];
+    if (slot.size === 0) {
+      return;
+    }
+    const timers = [...slot];
+    slot.clear();
+    this.size -= timers.length;
+    for (const timer of timers) {
+      timer.slot = null;
+      this.file(timer, timer.deadline);
+    }
+  }
+
+  file(timer, deadline) {
+    timer.deadline = deadline;
+    // Deadlines past the wheel's span wait at its far end and are re-filed
+    const at = Math.min(deadline, this.currentTick + MAX_SPAN - 1);
+    const delta = at - this.currentTick;
+    let level = 0;
+    let span = SLOTS;
+    while (delta >= span && level < LEVELS - 1) {
+      level++;
+      span *= SLOTS;
+    }
+    const index = Math.floor(at / (span / SLOTS)) & SLOT_MASK;
+    timer.slot = this.levels[level][index];
+    timer.slot.add(timer);
+    this.size++;
+  }
+}
+
+module.exports = TimerWheel;
@@ -0,0 +1,75 @@
+/**
+ * View Handles
+ *
+ * The one-byte entity handles of a single viewport client. A viewport
+ * client only ever holds the entities near it, so numbering them per
+ * socket rather than world-wide keeps handles plentiful however many
+ * entities the zone has: the world-wide DeltaTracker runs out at 255.
+ */
+
+const MAX_HANDLE = 255; // Handles are u8 on the wire; 0 means "no handle"
+
+class ViewHandles {
+  constructor() {
+    this.handles = new Map(); // entity -> handle
+    this.freeHandles = [];
+    this.clear();
+  }
+
+  /**
+   * Whether the client currently holds an entity
+   * @param {Object} entity - Player or Mob
+   * @returns {boolean}
+   */
+  has(entity) {
+    return this.handles.has(entity);
+  }
+
+  /**
+   * Handle of an entity, numbering it first if the client lacks it
+   * @param {Object} entity - Player or Mob
+   * @returns {number} - Handle, or 0 if every handle is taken
+   */
+  handleOf(entity) {
+    let handle = this.handles.get(entity);
+    if (handle === undefined) {
+      if (this.freeHandles.length === 0) {
+        return 0;
+      }
+      // FIFO reuse keeps a freed handle out of circulation as long as possible
+      handle = this.freeHandles.shift();
+      this.handles.set(entity, handle);
+    }
+    return handle;
+  }
+
+  /**
+   * Drop the entities the client should no longer hold
+   * @param {Set} keep - Entities that stay
+   * @returns {Array<number>} - Handles of the dropped entities
+   */
+  retain(keep) {
+    const removed = [];
+    for (const [entity, handle] of this.handles) {
+      if (!keep.has(entity)) {
+        this.handles.delete(entity);
+        this.freeHandles.push(handle);
+        removed.push(handle);
+      }
+    }
+    return removed;
+  }
+
+  /**
+   * Forget every entity (the client is about to get a full snapshot)
+   */
+  clear() {
+    this.handles.clear();
+    this.freeHandles = [];
+    for (let h = 1; h <= MAX_HANDLE; h++) {
+      this.freeHandles.push(h);
+    }
+  }
+}
+
+module.exports = ViewHandles;
@@ -2,21 +2,51 @@
  * World State Management
  * 
  * Manages the shared game world state including:
- * - World dimensions (40x20 grid)
+ * - World dimensions (40x20 by default; large maps are stored in chunks)
  * - Player entity tracking
- * - Position validation
+ * - Position validation and occupancy lookups (spatial grid)
  * - World persistence across client connections
  */
 
+const SpatialGrid = require('./spatial_grid');
+const DeltaTracker = require('./delta_tracker');
+const ReconnectCache = require('./reconnect_cache');
+const TimerWheel = require('./timer_wheel');
+const FlowField = require('./flow_field');
+const logger = require('./logger');
+
+const DEFAULT_TICK_MS = 100; // Tick length until a Simulation sets its own
+const KILL_MESSAGE_MS = 4000; // How long a kill/join message stays up
+const SPAWN_TRIES = 8; // Free cells drawn looking for one far enough from players
+const HUNT_RADIUS = 10; // Manhattan distance at which hunters notice players
+
 class World {
-  constructor(width = 40, height = 20) {
+  /**
+   * @param {number} width - World width in cells
+   * @param {number} height - World height in cells
+   * @param {Object} options - Optional tuning
+   * @param {number} options.reconnectCapacity - Disconnected players kept for rejoin
+   * @param {number} options.reconnectTtlMs - How long a disconnected player is kept
+   * @param {number} options.inactiveTimeoutMs - Idle time before a player is dropped
+   * @param {number} options.minSpawnDistance - Cells a spawn prefers to keep from players, best effort (0: any free cell)
+   */
+  constructor(width = 40, height = 20, options = {}) {
     this.width = width;
     this.height = height;
     this.players = new Map(); // playerId -> Player object
     this.mobs = new Map(); // mobId -> Mob object
-    this.disconnectedPlayers = new Map(); // playerName -> Player object (for reconnection)
+    this.grid = new SpatialGrid(width, height); // cell -> entities standing there
+    this.flowField = new FlowField(width, height); // Steps to the nearest player, for hunters
+    this.delta = new DeltaTracker(); // Entity handles + removal journal for delta state
+    // playerName -> Player object (for reconnection), LRU + TTL bounded
+    this.disconnectedPlayers = new ReconnectCache(options.reconnectCapacity, options.reconnectTtlMs);
     this.timestamp = Date.now();
     this.ticks = 0;
+    this.inTick = false; // True while tick() is advancing the world
+    this.tickMs = DEFAULT_TICK_MS; // Converts timer durations to ticks
+    this.timers = new TimerWheel(); // Inactivity, message expiry, respawn
+    this.inactiveTimeoutMs = options.inactiveTimeoutMs || 120000;
+    this.minSpawnDistance = options.minSpawnDistance || 0;
     this.lastCombatLog = '';
     this.lastCombatTimestamp = 0;
     this.lastCombatWinner = '';
@@ -25,7 +55,56 @@ class World {
     this.lastCombatMessages = [];
     this.lastKillMessage = '';
     this.lastKillTimestamp = 0;
-    this.previousPlayerNames = new Set(); // Track player names for rejoin detection
+    this.lastKillMessageTick = 0; // Tick the kill message last changed (for delta state)
+    this.killMessageTimer = null; // Clears the kill message when it expires
+    this.killListeners = []; // Called with each kill message (cluster kill feed)
+  }
+
+  /**
+   * Tick stamp for changes made now. Changes made while tick() runs belong
+   * to that tick; changes between ticks belong to the next one, so a
+   * client that acknowledged the current tick still receives them.
+   * @returns {number} - Change tick
+   */
+  changeTick() {
+    return this.inTick ? this.ticks : this.ticks + 1;
+  }
+
+  /**
+   * Ticks covering a duration, at least one
+   * @param {number} ms - Duration in ms
+   * @returns {number}
+   */
+  ticksFor(ms) {
+    return Math.max(1, Math.ceil(ms / this.tickMs));
+  }
+
+  /**
+   * Change the length of a tick. Pending timers are stretched so they
+   * still fire after the same time.
+   * @param {number} tickMs - Milliseconds per tick
+   */
+  setTickMs(tickMs) {
+    if (tickMs === this.tickMs) {
+      return;
+    }
+    this.timers.rescale(this.tickMs / tickMs);
+    this.tickMs = tickMs;
+  }
+
+  /**
+   * Change how long a player may idle; current players' deadlines move
+   * to their last activity plus the new timeout
+   * @param {number} timeoutMs - Idle time allowed
+   */
+  setInactiveTimeout(timeoutMs) {
+    this.inactiveTimeoutMs = timeoutMs;
+    const now = Date.now();
+    for (const player of this.players.values()) {
+      if (player.inactivityTimer) {
+        this.timers.reschedule(player.inactivityTimer, this.ticksFor(player.lastActivity + timeoutMs - now));
+      }
+    }
   }
 
   /**
@@ -38,11 +117,13 @@ class World {
       return false;
     }
     player.lastActivity = Date.now();  // Track activity for disconnect cleanup
-    this.players.set(player.id, player);
-    // Track player name for rejoin detection
-    if (player.name) {
-      this.previousPlayerNames.add(player.name);
+    const existing = this.players.get(player.id);
+    if (existing && existing !== player) {
+      this.untrackEntity(existing);
     }
+    this.players.set(player.id, player);
+    this.trackEntity(player);
+    this.scheduleInactivity(player);
     this.timestamp = Date.now();
     return true;
   }
@@ -51,26 +132,36 @@ class World {
     const player = this.players.get(playerId);
     if (player) {
       player.lastActivity = Date.now();
+      this.scheduleInactivity(player);
     }
   }
 
-  cleanupInactivePlayers(timeoutMs = 120000) {
-    // 120000ms = 2 minutes
-    const now = Date.now();
-    const inactivePlayers = [];
-
-    for (const [playerId, player] of this.players.entries()) {
-      if (now - player.lastActivity > timeoutMs) {
-        inactivePlayers.push({ id: playerId, name: player.name });
-        this.removePlayer(playerId);
-      }
+  /**
+   * (Re)arm a player's inactivity deadline; it fires from tick() and
+   * drops the player unless activity pushes it back first
+   * @param {Player} player - Player in the world
+   */
+  scheduleInactivity(player) {
+    const ticks = this.ticksFor(this.inactiveTimeoutMs);
+    if (player.inactivityTimer) {
+      this.timers.reschedule(player.inactivityTimer, ticks);
+    } else {
+      player.inactivityTimer = this.timers.schedule(ticks, () => {
+        if (this.players.get(player.id) === player) {
+          this.removePlayer(player.id);
+          logger.info('world.inactive', { name: player.name, id: player.id });
+        }
+      });
     }
-
-    return inactivePlayers;
   }
 
+  /**
+   * Whether a name belongs to a player still in the reconnect cache
+   * @param {string} playerName - Name to check
+   * @returns {boolean}
+   */
   isRejoiningPlayer(playerName) {
-    return this.previousPlayerNames.has(playerName);
+    return this.disconnectedPlayers.has(playerName);
   }
 
   /**
@@ -84,6 +175,9 @@ class World {
       // Store in disconnected players by name for reconnection
       this.disconnectedPlayers.set(player.name, player);
       this.players.delete(playerId);
+      this.untrackEntity(player);
+      this.timers.cancel(player.inactivityTimer);
+      player.inactivityTimer = null;
       this.timestamp = Date.now();
       return true;
     }
@@ -143,6 +237,73 @@ class World {
     return x >= 0 && x < this.width && y >= 0 && y < this.height;
   }
 
+  /**
+   * Pick a random unoccupied cell to spawn on. The minimum distance is a
+   * best-effort preference: a few free cells are drawn and the first with
+   * no player within that many cells (in either axis) wins; if none
+   * qualifies the one farthest from its nearest player is used, even
+   * though it is closer than asked.
+   * @param {number} minPlayerDistance - Cells to keep from players
+   * @returns {Object|null} - { x, y }, or null if every cell is occupied
+   */
+  findSpawnCell(minPlayerDistance = this.minSpawnDistance) {
+    let best = null;
+    let bestDistance = -1;
+    for (let i = 0; i < SPAWN_TRIES; i++) {
+      const cell = this.grid.randomFreeCell();
+      if (!cell || minPlayerDistance <= 0) {
+        return cell;
+      }
+      const distance = this.playerDistance(cell.x, cell.y, minPlayerDistance);
+      if (distance >= minPlayerDistance) {
+        return cell;
+      }
+      if (distance > bestDistance) {
+        best = cell;
+        bestDistance = distance;
+      }
+    }
+    return best;
+  }
+
+  /**
+   * Spawn position for a player: a free cell if there is one, any cell
+   * on a completely full map
+   * @returns {Object} - { x, y }
+   */
+  spawnPosition() {
+    return this.findSpawnCell() || {
+      x: Math.floor(Math.random() * this.width),
+      y: Math.floor(Math.random() * this.height)
+    };
+  }
+
+  /**
+   * Chebyshev distance from a cell to the nearest player, looking no
+   * further than `limit` cells
+   * @returns {number} - Distance, or `limit` if no player is closer
+   */
+  playerDistance(x, y, limit) {
+    let nearest = limit;
+    for (const entity of this.grid.queryRect(x - limit + 1, y - limit + 1, x + limit - 1, y + limit - 1)) {
+      if (entity.type === 'player') {
+        nearest = Math.min(nearest, Math.max(Math.abs(entity.x - x), Math.abs(entity.y - y)));
+      }
+    }
+    return nearest;
+  }
+
+  /**
+   * Whether mobs may step onto a cell. Every in-bounds cell for now;
+   * walls or terrain go here and hunter paths route around them.
+   * @param {number} x - X coordinate
+   * @param {number} y - Y coordinate
+   * @returns {boolean}
+   */
+  isWalkable(x, y) {
+    return this.isValidPosition(x, y);
+  }
+
   /**
    * Check if a position is occupied by another player
    * @param {number} x - X coordinate
@@ -151,13 +312,14 @@ class World {
    * @returns {Player|null} - Player at position or null if empty
    */
   getPlayerAtPosition(x, y, excludePlayerId = null) {
-    for (const player of this.players.values()) {
-      if (player.x === x && player.y === y) {
-        if (excludePlayerId && player.id === excludePlayerId) {
-          continue;
-        }
-        return player;
+    for (const entity of this.grid.getAt(x, y)) {
+      if (entity.type !== 'player') {
+        continue;
+      }
+      if (excludePlayerId && entity.id === excludePlayerId) {
+        continue;
       }
+      return entity;
     }
     return null;
   }
@@ -167,14 +329,47 @@ class World {
   }
 
   getMobAtPosition(x, y) {
-    for (const mob of this.mobs.values()) {
-      if (mob.x === x && mob.y === y) {
-        return mob;
+    for (const entity of this.grid.getAt(x, y)) {
+      if (entity.type === 'mob') {
+        return entity;
       }
     }
     return null;
   }
 
+  /**
+   * Index an entity in the spatial grid, give it a delta handle and let
+   * its setPosition report moves back to the world
+   * @param {Player|Mob} entity - Entity entering play
+   */
+  trackEntity(entity) {
+    this.grid.insert(entity);
+    this.delta.assign(entity);
+    entity.changedTick = this.changeTick();
+    entity.world = this;
+  }
+
+  /**
+   * Drop an entity from the spatial grid and journal its removal
+   * @param {Player|Mob} entity - Entity leaving play
+   */
+  untrackEntity(entity) {
+    this.grid.remove(entity);
+    this.delta.release(entity, this.changeTick());
+    if (entity.world === this) {
+      entity.world = null;
+    }
+  }
+
+  /**
+   * Called from an in-play entity's setPosition
+   * @param {Player|Mob} entity - Entity that moved
+   */
+  entityMoved(entity) {
+    this.grid.update(entity);
+    entity.changedTick = this.changeTick();
+  }
+
   /**
    * Add a mob to the world
    * @param {Mob} mob - Mob object to add
@@ -184,7 +379,12 @@ class World {
     if (!mob || !mob.id) {
       return false;
     }
+    const existing = this.mobs.get(mob.id);
+    if (existing && existing !== mob) {
+      this.untrackEntity(existing);
+    }
     this.mobs.set(mob.id, mob);
+    this.trackEntity(mob);
     this.timestamp = Date.now();
     return true;
   }
@@ -195,11 +395,14 @@ class World {
    * @returns {boolean} - Success status
    */
   removeMob(mobId) {
-    const removed = this.mobs.delete(mobId);
-    if (removed) {
-      this.timestamp = Date.now();
+    const mob = this.mobs.get(mobId);
+    if (!mob) {
+      return false;
     }
-    return removed;
+    this.mobs.delete(mobId);
+    this.untrackEntity(mob);
+    this.timestamp = Date.now();
+    return true;
   }
 
   setLastCombat(result) {
@@ -215,28 +418,61 @@ class World {
   }
 
   setKillMessage(winnerName, loserName, loserType) {
-    const now = Date.now();
     if (loserType === 'player') {
-      this.lastKillMessage = `${winnerName} killed ${loserName}!`;
+      this.showMessage(`${winnerName} killed ${loserName}!`);
     } else {
-      this.lastKillMessage = `${winnerName} killed ${loserName}`;
+      this.showMessage(`${winnerName} killed ${loserName}`);
+    }
+    for (const listener of this.killListeners) {
+      listener(this.lastKillMessage);
     }
-    this.lastKillTimestamp = now;
+  }
+
+  /**
+   * Register a callback run whenever a kill message is set
+   * @param {Function} listener - Called with the message text
+   */
+  onKill(listener) {
+    this.killListeners.push(listener);
+  }
+
+  /**
+   * Show a message that did not happen in this world (e.g. another
+   * zone's kill) in the kill message slot
+   * @param {string} text - Message text
+   */
+  setAnnouncement(text) {
+    this.showMessage(text);
   }
 
   setRejoinMessage(playerName) {
-    this.lastKillMessage = `${playerName} has rejoined the game!`;
-    this.lastKillTimestamp = Date.now();
+    this.showMessage(`${playerName} has rejoined the game!`);
   }
 
   setJoinMessage(playerName) {
-    this.lastKillMessage = `${playerName} joined the game!`;
+    this.showMessage(`${playerName} joined the game!`);
+  }
+
+  /**
+   * Put a message in the kill message slot and (re)arm its expiry
+   * @param {string} text - Message text
+   */
+  showMessage(text) {
+    this.lastKillMessage = text;
     this.lastKillTimestamp = Date.now();
+    this.lastKillMessageTick = this.changeTick();
+    const ticks = this.ticksFor(KILL_MESSAGE_MS);
+    if (this.killMessageTimer) {
+      this.timers.reschedule(this.killMessageTimer, ticks);
+    } else {
+      this.killMessageTimer = this.timers.schedule(ticks, () => this.clearKillMessage());
+    }
   }
 
   clearKillMessage() {
     this.lastKillMessage = '';
     this.lastKillTimestamp = 0;
+    this.timers.cancel(this.killMessageTimer);
   }
 
   /**
@@ -247,25 +483,35 @@ class World {
     return Array.from(this.mobs.values());
   }
 
+  /**
+   * Nearest player a hunter notices, from this tick's flow field
+   * @param {Mob} mob - Hunter looking for a target
+   * @returns {Object|null} - { target, distance } within HUNT_RADIUS, or null
+   */
+  huntTarget(mob) {
+    const found = this.flowField.at(mob.x, mob.y);
+    // A player killed earlier this tick is still in the field
+    return found && found.target.world === this ? found : null;
+  }
+
   /**
    * Update all mobs (move them randomly or toward players, and attack if adjacent)
    */
   updateMobs() {
     const CombatResolver = require('./combat');
+    let fieldReady = false;
     
     for (const mob of this.mobs.values()) {
       if (mob.isHunter) {
-        // Hunter mob: look for nearby players
-        let nearestPlayer = null;
-        let nearestDistance = Infinity;
-        
-        for (const player of this.players.values()) {
-          const distance = Math.abs(mob.x - player.x) + Math.abs(mob.y - player.y);
-          if (distance <= 10 && distance < nearestDistance) {
-            nearestPlayer = player;
-            nearestDistance = distance;
-          }
+        // Hunter mob: one flow field per tick, shared by every hunter,
+        // gives the nearest player in range and the way to it
+        if (!fieldReady) {
+          this.flowField.compute(this.players.values(), HUNT_RADIUS, (x, y) => this.isWalkable(x, y));
+          fieldReady = true;
         }
+        const found = this.huntTarget(mob);
+        const nearestPlayer = found ? found.target : null;
+        const nearestDistance = found ? found.distance : Infinity;
         
         // Track hunter state for logging
         const wasHunting = mob.lastTargetId !== undefined;
@@ -274,7 +520,7 @@ class World {
         if (nearestPlayer) {
           // Log when hunter locks on to a new target
           if (!wasHunting || mob.lastTargetId !== nearestPlayer.id) {
-            console.log(`  🎯 Hunter locked on: "${nearestPlayer.name}" at distance ${nearestDistance}`);
+            logger.debug('hunter.lock', { hunter: mob.name, target: nearestPlayer.name, distance: nearestDistance });
             mob.lastTargetId = nearestPlayer.id;
           }
           
@@ -287,21 +533,20 @@ class World {
             if (combatResult.finalLoserId === nearestPlayer.id) {
               this.removePlayer(nearestPlayer.id);
               this.setKillMessage(combatResult.finalWinnerName, combatResult.finalLoserName, 'player');
-              console.log(`  ⚔️  Hunter Combat: "${mob.name}" vs "${nearestPlayer.name}" - Winner: "${combatResult.finalWinnerName}" (${combatResult.finalScore})`);
             } else {
               this.removeMob(mob.id);
-              console.log(`  ⚔️  Hunter Combat: "${mob.name}" vs "${nearestPlayer.name}" - Winner: "${combatResult.finalWinnerName}" (${combatResult.finalScore})`);
             }
+            logger.info('hunter.combat', { hunter: mob.name, player: nearestPlayer.name, winner: combatResult.finalWinnerName, score: combatResult.finalScore });
             this.setLastCombat(combatResult);
           } else {
             // Not adjacent, move toward player with slowdown when very close
-            mob.moveToward(nearestPlayer.x, nearestPlayer.y, this.width, this.height, true);
+            mob.moveAlong(this.flowField, true);
           }
         } else {
           // No player in range
           if (wasHunting) {
             // Log when hunter loses target
-            console.log(`  🔍 Hunter lost target, resuming patrol`);
+            logger.debug('hunter.lost', { hunter: mob.name });
             mob.lastTargetId = undefined;
           }
           // Move randomly
@@ -317,38 +562,36 @@ class World {
   /**
    * Ensure minimum mob count, spawn new ones if needed
    * @param {number} minMobs - Minimum number of mobs to maintain
+   * @param {number} maxHunters - Hunters among them (spawned first)
    * @returns {Array} - Array of newly spawned mobs
    */
-  respawnMobs(minMobs = 3) {
+  respawnMobs(minMobs = 3, maxHunters = 1) {
     const spawnedMobs = [];
     const currentCount = this.mobs.size;
     
     if (currentCount < minMobs) {
+      let hunters = 0;
+      for (const mob of this.mobs.values()) {
+        if (mob.isHunter) {
+          hunters++;
+        }
+      }
       const toSpawn = minMobs - currentCount;
       
       for (let i = 0; i < toSpawn; i++) {
-        // Generate random position
-        let x, y;
-        let attempts = 0;
-        do {
-          x = Math.floor(Math.random() * this.width);
-          y = Math.floor(Math.random() * this.height);
-          attempts++;
-        } while (this.getPlayerAtPosition(x, y) !== null && attempts < 10);
-        
-        // Determine if this should be a hunter mob
-        // Only one hunter at a time - check if one exists
-        let hasHunter = false;
-        for (const mob of this.mobs.values()) {
-          if (mob.isHunter) {
-            hasHunter = true;
-            break;
-          }
+        const cell = this.findSpawnCell();
+        if (!cell) {
+          break; // Map full
         }
+        const { x, y } = cell;
         
-        const isHunter = !hasHunter && i === 0;  // First spawn is hunter if none exists
+        // Spawns are hunters until there are maxHunters of them
+        const isHunter = hunters < maxHunters;
+        if (isHunter) {
+          hunters++;
+        }
         const mobId = `mob_${Date.now()}_${Math.random().toString(36).substr(2, 9)}`;
-        const mobName = isHunter ? 'Hunter' : `Goblin${currentCount + i + 1}`;
+        const mobName = isHunter ? (hunters === 1 ? 'Hunter' : `Hunter${hunters}`) : `Goblin${currentCount + i + 1}`;
         
         const mob = new (require('./mob'))(mobId, mobName, x, y, isHunter);
         this.addMob(mob);
@@ -360,23 +603,32 @@ class World {
   }
 
   /**
-   * Get world state snapshot for API responses
+   * Advance the simulation by one tick (driven by the Simulation loop)
+   */
+  tick() {
+    this.ticks++;
+    this.inTick = true;
+    this.delta.prune(this.ticks);
+
+    try {
+      /* Update mobs every tick */
+      this.updateMobs();
+
+      /* Forget disconnected players past the reconnect TTL */
+      this.disconnectedPlayers.expire(Date.now());
+
+      /* Due timers: inactivity, kill message expiry, respawn */
+      this.timers.advance(this.ticks);
+    } finally {
+      this.inTick = false;
+    }
+  }
+
+  /**
+   * Get world state snapshot for API responses (read-only)
    * @returns {Object} - World state object
    */
   getState() {
-    this.ticks++;  /* Increment world ticks on each state query */
-    
-    /* Update mobs every tick */
-    this.updateMobs();
-    
-    /* Auto-clear kill message after 4 seconds */
-    if (this.lastKillMessage && this.lastKillTimestamp) {
-      const elapsed = Date.now() - this.lastKillTimestamp;
-      if (elapsed > 4000) {
-        this.clearKillMessage();
-      }
-    }
-    
     /* Combine players and mobs for the response */
     const allEntities = [
       ...this.getAllPlayers().map(p => ({
@@ -419,8 +671,18 @@ class World {
    * Reset world to initial state
    */
   reset() {
+    for (const entity of [...this.players.values(), ...this.mobs.values()]) {
+      entity.world = null;
+      entity.handle = 0;
+    }
+    for (const player of this.players.values()) {
+      this.timers.cancel(player.inactivityTimer);
+      player.inactivityTimer = null;
+    }
     this.players.clear();
     this.mobs.clear();
+    this.grid.clear();
+    this.delta.reset(this.ticks);
     this.timestamp = Date.now();
     this.lastCombatLog = '';
     this.lastCombatTimestamp = 0;
@@ -428,8 +690,7 @@ class World {
     this.lastCombatLoser = '';
     this.lastCombatScore = '';
     this.lastCombatMessages = [];
-    this.lastKillMessage = '';
-    this.lastKillTimestamp = 0;
+    this.clearKillMessage();
   }
 }
 
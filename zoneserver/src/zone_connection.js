@@ -0,0 +1,100 @@
+/**
+ * Zone Connection
+ *
+ * Stand-in for a net.Socket inside a zone worker. The front end owns the
+ * real socket and forwards its bytes over the worker's message port; this
+ * object gives TcpServer the socket surface it uses (data/close events,
+ * write, cork/uncork, destroy) and posts everything it writes back to the
+ * front end. Writes made while corked leave as one message, so a reply
+ * and its delta still reach the wire together. Each message carries an
+ * exact-size copy whose buffer is transferred, not cloned: frames are
+ * views into pooled or reused memory far larger than the frame.
+ */
+
+const { EventEmitter } = require('events');
+
+class ZoneConnection extends EventEmitter {
+  /**
+   * @param {MessagePort} port - Port to the front end
+   * @param {number} id - Connection ID assigned by the front end
+   * @param {string} remoteAddress - Client address, for logging
+   */
+  constructor(port, id, remoteAddress) {
+    super();
+    this.port = port;
+    this.id = id;
+    this.remoteAddress = remoteAddress;
+    this.destroyed = false;
+    this.corked = 0;
+    this.pending = [];
+  }
+
+  write(frame) {
+    if (this.destroyed) {
+      return false;
+    }
+    if (this.corked > 0) {
+      this.pending.push(frame);
+      return true;
+    }
+    this.post([frame]);
+    return true;
+  }
+
+  cork() {
+    this.corked++;
+  }
+
+  uncork() {
+    if (this.corked === 0 || --this.corked > 0) {
+      return;
+    }
+    if (this.pending.length > 0) {
+      const frames = this.pending;
+      this.pending = [];
+      if (!this.destroyed) {
+        this.post(frames);
+      }
+    }
+  }
+
+  post(frames) {
+    let length = 0;
+    for (const frame of frames) {
+      length += frame.length;
+    }
+    const data = new Uint8Array(length);
+    let offset = 0;
+    for (const frame of frames) {
+      data.set(frame, offset);
+      offset += frame.length;
+    }
+    this.port.postMessage({ type: 'write', id: this.id, data }, [data.buffer]);
+  }
+
+  /**
+   * Close the client's socket (sent to the front end) and drop the player
+   */
+  destroy() {
+    if (this.destroyed) {
+      return;
+    }
+    this.destroyed = true;
+    this.pending = [];
+    this.port.postMessage({ type: 'end', id: this.id });
+    process.nextTick(() => this.emit('close')); // Asynchronous, like net.Socket
+  }
+
+  /**
+   * The front end saw the client's socket close
+   */
+  closed() {
+    if (this.destroyed) {
+      return;
+    }
+    this.destroyed = true;
+    this.emit('close');
+  }
+}
+
+module.exports = ZoneConnection;
@@ -0,0 +1,221 @@
+/**
+ * Zone Host
+ *
+ * Front end for a sharded server. Runs one zone worker (zone_worker.js)
+ * per zone, each with its own World and tick loop, and owns the TCP port:
+ * every accepted socket is routed to the zone with the fewest connections
+ * and its bytes are relayed to and from that worker by message passing.
+ * Zones are independent, so capacity grows with the number of cores.
+ * REST API requests are forwarded to a zone with request(). A zone whose
+ * worker dies loses its clients and in-flight requests and is restarted
+ * with a fresh world; until it is ready again no new clients go to it.
+ */
+
+const net = require('net');
+const path = require('path');
+const { Worker } = require('worker_threads');
+const logger = require('./logger');
+
+const WORKER_PATH = path.join(__dirname, 'zone_worker.js');
+const RESTART_DELAY_MS = 1000; // Pause before restarting a zone whose worker died
+
+class ZoneHost {
+  /**
+   * @param {number} port - TCP port to listen on (0 picks a free one)
+   * @param {Object} options - Zone configuration
+   * @param {number} options.zones - Number of zones (worker threads)
+   * @param {Object} options.zone - World and Simulation settings of every zone (zone_options.js)
+   * @param {boolean} options.quiet - Discard zone log output
+   */
+  constructor(port, options = {}) {
+    this.port = port;
+    this.options = options;
+    this.zones = []; // zone id -> { id, worker, connections, ready }
+    this.sockets = new Map(); // connection id -> { socket, zone }
+    this.nextId = 1;
+    this.nextRequestId = 1;
+    this.requests = new Map(); // rid -> { zone, resolve, reject }
+    this.stopping = false;
+    this.server = net.createServer(this.handleConnection.bind(this));
+  }
+
+  /**
+   * Start the zone workers, then listen
+   * @returns {Promise} - Resolves once every zone is ready and the port is open
+   */
+  async start() {
+    const count = Math.max(1, this.options.zones || 1);
+    const ready = [];
+    for (let id = 0; id < count; id++) {
+      ready.push(this.startZone(id));
+    }
+    await Promise.all(ready);
+    await new Promise(resolve => this.server.listen(this.port, resolve));
+    logger.info('tcp.listen', { port: this.server.address().port, zones: count });
+  }
+
+  startZone(id) {
+    const worker = new Worker(WORKER_PATH, {
+      workerData: { zoneId: id, zone: this.options.zone || {} },
+      stdout: !!this.options.quiet
+    });
+    if (this.options.quiet) {
+      worker.stdout.resume();
+    }
+    const zone = { id, worker, connections: 0, ready: false };
+    this.zones[id] = zone;
+
+    worker.on('message', msg => this.handleZoneMessage(zone, msg));
+    worker.on('error', err => logger.error('zone.failed', { zone: id, error: err.message }));
+    worker.on('exit', code => this.handleZoneExit(zone, code));
+
+    return new Promise((resolve, reject) => {
+      const onReady = (msg) => {
+        if (msg.type === 'ready') {
+          worker.off('message', onReady);
+          zone.ready = true;
+          resolve();
+        }
+      };
+      worker.on('message', onReady);
+      worker.once('error', reject);
+      worker.once('exit', () => reject(new Error(`Zone ${id} exited before it was ready`)));
+    });
+  }
+
+  /**
+   * Stop listening and terminate every zone
+   */
+  async stop() {
+    this.stopping = true;
+    await new Promise(resolve => this.server.close(() => resolve()));
+    for (const { socket } of this.sockets.values()) {
+      socket.destroy();
+    }
+    await Promise.all(this.zones.map(zone => zone.worker.terminate()));
+  }
+
+  /**
+   * Least-loaded running zone for a new connection
+   * @returns {Object|null} - Zone, or null if none is running
+   */
+  pickZone() {
+    let best = null;
+    for (const zone of this.zones) {
+      if (zone.ready && (!best || zone.connections < best.connections)) {
+        best = zone;
+      }
+    }
+    return best;
+  }
+
+  handleConnection(socket) {
+    const zone = this.pickZone();
+    if (!zone) {
+      socket.destroy();
+      return;
+    }
+    const id = this.nextId++;
+    zone.connections++;
+    this.sockets.set(id, { socket, zone });
+    zone.worker.postMessage({ type: 'open', id, remoteAddress: socket.remoteAddress });
+
+    socket.on('data', data => zone.worker.postMessage({ type: 'data', id, data }));
+    socket.on('close', () => {
+      if (this.sockets.delete(id)) {
+        zone.connections--;
+        zone.worker.postMessage({ type: 'close', id });
+      }
+    });
+    socket.on('error', err => logger.warn('tcp.socket_error', { error: err.message }));
+  }
+
+  handleZoneMessage(zone, msg) {
+    switch (msg.type) {
+      case 'write': {
+        const entry = this.sockets.get(msg.id);
+        if (entry && !entry.socket.destroyed) {
+          entry.socket.write(Buffer.from(msg.data.buffer, msg.data.byteOffset, msg.data.byteLength));
+        }
+        break;
+      }
+      case 'end': {
+        const entry = this.sockets.get(msg.id);
+        if (entry) {
+          this.sockets.delete(msg.id);
+          zone.connections--;
+          entry.socket.destroy();
+        }
+        break;
+      }
+      case 'http': {
+        const pending = this.requests.get(msg.rid);
+        if (pending) {
+          this.requests.delete(msg.rid);
+          pending.resolve({ status: msg.status, body: msg.body });
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  /**
+   * A zone's worker is gone: close its clients, fail its requests and,
+   * unless we are shutting down, start it again
+   */
+  handleZoneExit(zone, code) {
+    zone.ready = false;
+    for (const [id, entry] of this.sockets) {
+      if (entry.zone === zone) {
+        this.sockets.delete(id);
+        entry.socket.destroy();
+      }
+    }
+    zone.connections = 0;
+    for (const [rid, pending] of this.requests) {
+      if (pending.zone === zone) {
+        this.requests.delete(rid);
+        pending.reject(new Error(`Zone ${zone.id} exited`));
+      }
+    }
+
+    if (this.stopping || this.zones[zone.id] !== zone) {
+      return;
+    }
+    logger.error('zone.exit', { zone: zone.id, code });
+    setTimeout(() => {
+      if (!this.stopping) {
+        this.startZone(zone.id).catch(() => {}); // A failed start exits and retries
+      }
+    }, RESTART_DELAY_MS).unref();
+  }
+
+  /**
+   * Run a REST API request in a zone
+   * @param {number} zoneId - Zone to ask
+   * @param {Object} req - { method, url, query, body }, url relative to /api
+   * @returns {Promise<Object>} - { status, body }
+   */
+  request(zoneId, req) {
+    const zone = this.zones[zoneId];
+    if (!zone || !zone.ready) {
+      return Promise.reject(new Error(`Zone ${zoneId} is not running`));
+    }
+    const rid = this.nextRequestId++;
+    return new Promise((resolve, reject) => {
+      this.requests.set(rid, { zone, resolve, reject });
+      zone.worker.postMessage({
+        type: 'http',
+        rid,
+        method: req.method,
+        url: req.url,
+        query: req.query,
+        body: req.body
+      });
+    });
+  }
+}
+
+module.exports = ZoneHost;
@@ -0,0 +1,34 @@
+/**
+ * Zone Options
+ *
+ * The settings each zone's World and Simulation are built from, read from
+ * the environment in one place. The single-zone server, ZoneHost (as
+ * workerData) and ClusterRouter (in the fork config) all pass the same
+ * object along unchanged, and every zone hands it straight to
+ * new World(...) and new Simulation(...), so a new zone setting is added
+ * here and nowhere else.
+ */
+
+/**
+ * Read zone settings from the environment
+ * @param {Object} env - Variables to read
+ * @returns {Object} - Options for World and Simulation
+ */
+function fromEnv(env = process.env) {
+  const int = (name, fallback) => parseInt(env[name] || String(fallback), 10);
+  return {
+    // Maps wider or taller than 256 cells need clients that join with wide (u16) positions
+    width: int('WORLD_WIDTH', 40),
+    height: int('WORLD_HEIGHT', 20),
+    tickRate: int('TICK_RATE', 10), // Simulation ticks per second
+    minMobs: int('MIN_MOBS', 3), // Mob population respawn keeps up
+    hunters: int('HUNTERS', 1), // Hunter mobs among them
+    // Disconnected players kept for rejoin: at most this many, for at most this long
+    reconnectCapacity: int('RECONNECT_CAPACITY', 1024),
+    reconnectTtlMs: int('RECONNECT_TTL_MS', 1800000),
+    // Spawns prefer cells at least this far from any player (best effort, see World.findSpawnCell)
+    minSpawnDistance: int('SPAWN_DISTANCE', 0)
+  };
+}
+
+module.exports = { fromEnv };
@@ -0,0 +1,85 @@
+/**
+ * Zone Process
+ *
+ * Child process started by the cluster router (cluster_router.js). Hosts
+ * the zones assigned to it, each an ordinary World + Simulation +
+ * TcpServer on this process's event loop, and serves the client sockets
+ * the router hands over for them.
+ *
+ * IPC from the router:
+ *   { type: 'socket', zone, head } + socket handle - A client for `zone`;
+ *                                     `head` is the base64 of bytes the
+ *                                     router already read from it
+ *   { type: 'kill', zone, text }   - Kill in another zone, for the feed
+ * IPC to the router:
+ *   { type: 'ready' }
+ *   { type: 'kill', zone, text }   - Kill in one of our zones
+ *   { type: 'population', zone, players } - Periodic player count
+ */
+
+const World = require('./world');
+const Simulation = require('./simulation');
+const TcpServer = require('./tcp_server');
+const logger = require('./logger');
+
+const POPULATION_INTERVAL_MS = 1000;
+
+const config = JSON.parse(process.env.KZ_ZONE_CONFIG || '{}');
+if (config.quiet) {
+  logger.configure({ level: 'silent' });
+}
+
+const options = config.zone || {}; // World and Simulation settings
+const zones = new Map(); // zone number -> { world, simulation, tcpServer }
+
+for (const zoneId of config.zones || [0]) {
+  const world = new World(options.width, options.height, options);
+  const simulation = new Simulation(world, options);
+  const tcpServer = new TcpServer(world, null); // Sockets arrive from the router
+  simulation.onTick(() => tcpServer.pushUpdates());
+  world.onKill((text) => {
+    if (process.connected) {
+      process.send({ type: 'kill', zone: zoneId, text });
+    }
+  });
+  world.respawnMobs(simulation.minMobs, simulation.hunters);
+  simulation.start();
+  zones.set(zoneId, { world, simulation, tcpServer });
+}
+
+process.on('message', (msg, handle) => {
+  if (msg.type === 'socket') {
+    const zone = zones.get(msg.zone);
+    if (!zone || !handle) {
+      if (handle) {
+        handle.destroy();
+      }
+      return;
+    }
+    zone.tcpServer.handleConnection(handle);
+    zone.tcpServer.handleData(handle, Buffer.from(msg.head, 'base64'));
+  } else if (msg.type === 'kill') {
+    // Kill feed: other zones' kills show in every zone we host
+    for (const [zoneId, zone] of zones) {
+      if (zoneId !== msg.zone) {
+        zone.world.setAnnouncement(`[Z${msg.zone}] ${msg.text}`);
+      }
+    }
+  }
+});
+
+const populationTimer = setInterval(() => {
+  if (!process.connected) {
+    return;
+  }
+  for (const [zoneId, zone] of zones) {
+    process.send({ type: 'population', zone: zoneId, players: zone.world.getPlayerCount() });
+  }
+}, POPULATION_INTERVAL_MS);
+
+// The router is gone (shutdown or crash): nobody is left to route to us
+process.on('disconnect', () => {
+  clearInterval(populationTimer);
+  process.exit(0);
+});
+process.send({ type: 'ready' });
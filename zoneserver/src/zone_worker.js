@@ -0,0 +1,92 @@
+/**
+ * Zone Worker
+ *
+ * Entry point of a worker_thread that owns one zone: its World, its
+ * fixed-rate Simulation and the TcpServer protocol logic for the clients
+ * routed to it. The worker never listens on a port. The front end
+ * (ZoneHost) forwards each client's bytes here and writes back whatever
+ * the zone sends, so zones share nothing and tick in parallel.
+ *
+ * Messages from the front end:
+ *   { type: 'open', id, remoteAddress }  - A client was routed here
+ *   { type: 'data', id, data }           - Bytes from that client
+ *   { type: 'close', id }                - The client's socket closed
+ *   { type: 'http', rid, method, url, query, body } - REST API request
+ * Messages to the front end:
+ *   { type: 'ready', zoneId }
+ *   { type: 'write', id, data }          - Bytes for a client
+ *   { type: 'end', id }                  - Close a client's socket
+ *   { type: 'http', rid, status, body }  - REST API response
+ */
+
+const { parentPort, workerData } = require('worker_threads');
+const World = require('./world');
+const Simulation = require('./simulation');
+const TcpServer = require('./tcp_server');
+const ZoneConnection = require('./zone_connection');
+const createApiRoutes = require('./routes/api');
+
+const { zoneId, zone: options } = workerData;
+const world = new World(options.width, options.height, options);
+const simulation = new Simulation(world, options);
+const tcpServer = new TcpServer(world, null); // Protocol only; the front end owns the port
+const api = createApiRoutes(world);
+const connections = new Map(); // id -> ZoneConnection
+
+simulation.onTick(() => tcpServer.pushUpdates());
+
+/**
+ * Run a forwarded REST request through this zone's API router
+ */
+function handleHttp(msg) {
+  const req = { method: msg.method, url: msg.url, query: msg.query || {}, body: msg.body || {}, headers: {} };
+  const res = {
+    statusCode: 200,
+    status(code) {
+      this.statusCode = code;
+      return this;
+    },
+    json(body) {
+      parentPort.postMessage({ type: 'http', rid: msg.rid, status: this.statusCode, body });
+      return this;
+    }
+  };
+  api(req, res, () => {
+    parentPort.postMessage({ type: 'http', rid: msg.rid, status: 404, body: { success: false, error: 'Endpoint not found' } });
+  });
+}
+
+parentPort.on('message', (msg) => {
+  switch (msg.type) {
+    case 'open': {
+      const conn = new ZoneConnection(parentPort, msg.id, msg.remoteAddress);
+      connections.set(msg.id, conn);
+      conn.on('close', () => connections.delete(msg.id));
+      tcpServer.handleConnection(conn);
+      break;
+    }
+    case 'data': {
+      const conn = connections.get(msg.id);
+      if (conn && !conn.destroyed) {
+        conn.emit('data', Buffer.from(msg.data.buffer, msg.data.byteOffset, msg.data.byteLength));
+      }
+      break;
+    }
+    case 'close': {
+      const conn = connections.get(msg.id);
+      if (conn) {
+        conn.closed();
+      }
+      break;
+    }
+    case 'http':
+      handleHttp(msg);
+      break;
+    default:
+      break;
+  }
+});
+
+world.respawnMobs(simulation.minMobs, simulation.hunters);
+simulation.start();
+parentPort.postMessage({ type: 'ready', zoneId });
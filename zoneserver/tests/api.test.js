@@ -19,6 +19,9 @@ describe('API Endpoints', () => {
       expect(res.body.status).toBe('healthy');
       expect(res.body.uptime).toBeDefined();
       expect(res.body.playerCount).toBeDefined();
+      expect(res.body.reconnectCache.hits).toBeDefined();
+      expect(res.body.reconnectCache.misses).toBeDefined();
+      expect(res.body.reconnectCache.evictions).toBeDefined();
       expect(res.body.timestamp).toBeDefined();
     });
 
@@ -0,0 +1,131 @@
+const net = require('net');
+const { once } = require('events');
+const ClusterRouter = require('../src/cluster_router');
+
+function buildZoneJoinPacket(name, zone) {
+  const nameBuf = Buffer.from(name);
+  return Buffer.concat([Buffer.from([0x08, 0x02, 10, 6, nameBuf.length]), nameBuf, Buffer.from([zone])]);
+}
+
+function readFrame(socket, timeoutMs = 3000) {
+  return new Promise((resolve, reject) => {
+    const timer = setTimeout(() => {
+      socket.off('data', onData);
+      reject(new Error(`Timed out waiting for socket data (${timeoutMs}ms)`));
+    }, timeoutMs);
+    const onData = (chunk) => {
+      clearTimeout(timer);
+      socket.off('data', onData);
+      resolve(chunk);
+    };
+    socket.on('data', onData);
+  });
+}
+
+async function connect(port) {
+  const client = net.createConnection({ port, host: '127.0.0.1' });
+  await once(client, 'connect');
+  return client;
+}
+
+function waitFor(condition, timeoutMs = 3000) {
+  return new Promise((resolve, reject) => {
+    const started = Date.now();
+    const poll = setInterval(() => {
+      if (condition()) {
+        clearInterval(poll);
+        resolve();
+      } else if (Date.now() - started > timeoutMs) {
+        clearInterval(poll);
+        reject(new Error('Timed out waiting for condition'));
+      }
+    }, 50);
+  });
+}
+
+describe('Cluster Router', () => {
+  let router;
+  let logSpy;
+  const sockets = [];
+
+  beforeAll(async () => {
+    logSpy = jest.spyOn(console, 'log').mockImplementation(() => {});
+    router = new ClusterRouter(0, { processes: 2, zones: 2, zone: { minMobs: 0 }, routingTimeoutMs: 300, quiet: true });
+    await router.start();
+  });
+
+  afterAll(async () => {
+    for (const socket of sockets) {
+      socket.destroy();
+    }
+    await router.stop();
+    logSpy.mockRestore();
+  });
+
+  test('routes joins to the process hosting the requested zone', async () => {
+    const { port } = router.server.address();
+    const alice = await connect(port);
+    const bob = await connect(port);
+    sockets.push(alice, bob);
+
+    alice.write(buildZoneJoinPacket('Alice', 0));
+    expect((await readFrame(alice)).readUInt8(2)).toBe(0x01);
+    bob.write(buildZoneJoinPacket('Bob', 1));
+    expect((await readFrame(bob)).readUInt8(2)).toBe(0x01);
+
+    // 0x03 state: each zone holds only its own player
+    alice.write(Buffer.from([0x03]));
+    expect((await readFrame(alice)).readUInt8(3)).toBe(1);
+    bob.write(Buffer.from([0x03]));
+    expect((await readFrame(bob)).readUInt8(3)).toBe(1);
+
+    // Zone processes report their populations to the router
+    await waitFor(() => router.population[0] === 1 && router.population[1] === 1);
+    expect(router.playerCount()).toBe(2);
+  });
+
+  test('sends joins without a zone, or for an unknown zone, to zone 0', async () => {
+    const { port } = router.server.address();
+    const carol = await connect(port);
+    const dave = await connect(port);
+    sockets.push(carol, dave);
+
+    carol.write(Buffer.from([0x01, 5, ...Buffer.from('Carol')]));
+    expect((await readFrame(carol)).readUInt8(2)).toBe(0x01);
+    dave.write(buildZoneJoinPacket('Dave', 9));
+    expect((await readFrame(dave)).readUInt8(2)).toBe(0x01);
+
+    await waitFor(() => router.population[0] === 3);
+    expect(router.population[1]).toBe(1);
+  });
+
+  test('drops connections that never send a first frame', async () => {
+    const { port } = router.server.address();
+    const idle = await connect(port);
+    sockets.push(idle);
+    await once(idle, 'close');
+  });
+
+  test('refuses clients for a dead process until it has been restarted', async () => {
+    const { port } = router.server.address();
+    const dead = router.children[1];
+    const bob = sockets[1]; // In zone 1 since the first test
+    const closed = once(bob, 'close');
+    dead.kill();
+    await once(dead, 'exit');
+    await closed;
+    expect(router.population[1]).toBe(0);
+
+    const early = await connect(port);
+    sockets.push(early);
+    const refused = once(early, 'close');
+    early.write(buildZoneJoinPacket('Early', 1));
+    await refused;
+
+    await waitFor(() => router.children[1] !== dead && router.children[1].ready);
+    const erin = await connect(port);
+    sockets.push(erin);
+    erin.write(buildZoneJoinPacket('Erin', 1));
+    expect((await readFrame(erin)).readUInt8(2)).toBe(0x01);
+  });
+});
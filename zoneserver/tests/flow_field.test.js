@@ -0,0 +1,34 @@
+const FlowField = require('../src/flow_field');
+
+const open = () => true;
+
+describe('FlowField', () => {
+  test('measures steps to the nearest source', () => {
+    const field = new FlowField(20, 10);
+    const alice = { x: 2, y: 2 };
+    const bob = { x: 15, y: 7 };
+    field.compute([alice, bob], 10, open);
+
+    expect(field.at(2, 2)).toEqual({ distance: 0, target: alice });
+    expect(field.at(5, 4)).toEqual({ distance: 5, target: alice });
+    expect(field.at(14, 5)).toEqual({ distance: 3, target: bob });
+    expect(field.at(19, 0)).toBeNull(); // Past the radius of both
+  });
+
+  test('steps lead to the source around walls', () => {
+    // Wall at x = 5 from y = 0 to 8; the only gap is at y = 9
+    const walkable = (x, y) => !(x === 5 && y < 9);
+    const field = new FlowField(10, 10);
+    field.compute([{ x: 8, y: 0 }], 30, walkable);
+
+    let pos = { x: 2, y: 0 };
+    const start = field.at(pos.x, pos.y).distance;
+    expect(start).toBe(6 + 9 + 9); // Down to the gap, across, back up
+    for (let i = 0; i < start; i++) {
+      pos = field.nextStep(pos.x, pos.y);
+      expect(walkable(pos.x, pos.y)).toBe(true);
+    }
+    expect(pos).toEqual({ x: 8, y: 0 });
+    expect(field.nextStep(8, 0)).toBeNull();
+  });
+});
@@ -0,0 +1,34 @@
+const FrameEncoder = require('../src/frame_encoder');
+
+describe('FrameEncoder', () => {
+  test('encodes fields in order after a u16 length header', () => {
+    const enc = new FrameEncoder(16);
+    const frame = enc.begin()
+      .u8(0x02)
+      .u16(0x1234)
+      .lenString('hello world', 5)
+      .lenBytes(Buffer.from([9, 8]))
+      .finish();
+
+    expect(Array.from(frame)).toEqual([12, 0, 0x02, 0x34, 0x12, 5, 104, 101, 108, 108, 111, 2, 9, 8]);
+  });
+
+  test('finished frames do not alias the scratch buffer', () => {
+    const enc = new FrameEncoder(8);
+    const first = enc.begin().u8(1).u8(2).finish();
+    enc.begin().u8(7).u8(7).finish();
+
+    expect(Array.from(first)).toEqual([2, 0, 1, 2]);
+  });
+
+  test('grows the scratch buffer when a frame outgrows it', () => {
+    const enc = new FrameEncoder(4);
+    const payload = Buffer.alloc(100, 0xAB);
+    const frame = enc.begin().u8(0x03).bytes(payload).finish();
+
+    expect(frame.length).toBe(103);
+    expect(frame.readUInt16LE(0)).toBe(101);
+    expect(frame[102]).toBe(0xAB);
+    expect(enc.buf.length).toBeGreaterThanOrEqual(103);
+  });
+});
@@ -0,0 +1,27 @@
+const FreeCells = require('../src/free_cells');
+
+describe('FreeCells', () => {
+  test('finds the chunk holding the k-th free cell', () => {
+    const free = new FreeCells([4, 4, 2]);
+    expect(free.total).toBe(10);
+    expect(free.find(0)).toEqual({ chunk: 0, rank: 0 });
+    expect(free.find(5)).toEqual({ chunk: 1, rank: 1 });
+    expect(free.find(9)).toEqual({ chunk: 2, rank: 1 });
+  });
+
+  test('skips chunks with no free cells left', () => {
+    const free = new FreeCells([2, 2, 2, 2, 2]);
+    free.take(1);
+    free.take(1);
+    free.take(3);
+    expect(free.total).toBe(7);
+    expect(free.find(2)).toEqual({ chunk: 2, rank: 0 });
+    expect(free.find(4)).toEqual({ chunk: 3, rank: 0 });
+    expect(free.find(5)).toEqual({ chunk: 4, rank: 0 });
+
+    free.release(1);
+    expect(free.find(2)).toEqual({ chunk: 1, rank: 0 });
+    free.reset();
+    expect(free.total).toBe(10);
+  });
+});
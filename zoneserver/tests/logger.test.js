@@ -0,0 +1,66 @@
+const { Writable } = require('stream');
+const { Logger } = require('../src/logger');
+
+function memoryStream() {
+  const stream = new Writable({
+    write(chunk, encoding, callback) {
+      stream.chunks.push(chunk.toString());
+      callback();
+    }
+  });
+  stream.chunks = [];
+  stream.lines = () => stream.chunks.join('').split('\n').filter(Boolean).map(line => JSON.parse(line));
+  return stream;
+}
+
+describe('Logger', () => {
+  test('writes structured lines at or above the level', () => {
+    const stream = memoryStream();
+    const logger = new Logger({ level: 'info', stream, sample: {} });
+
+    logger.debug('tcp.move', { x: 1 });
+    logger.info('tcp.join', { name: 'Alice' });
+    logger.error('tcp.error', { error: 'boom' });
+    expect(logger.enabled('debug')).toBe(false);
+    expect(logger.enabled('warn')).toBe(true);
+
+    logger.flush();
+    const lines = stream.lines();
+    expect(lines.map(line => line.event)).toEqual(['tcp.join', 'tcp.error']);
+    expect(lines[0]).toMatchObject({ level: 'info', name: 'Alice' });
+  });
+
+  test('buffers lines into one write per flush', () => {
+    const stream = memoryStream();
+    const logger = new Logger({ level: 'info', stream, sample: {} });
+
+    for (let i = 0; i < 5; i++) {
+      logger.info('http.request', { i });
+    }
+    expect(stream.chunks).toHaveLength(0);
+    logger.flush();
+    expect(stream.chunks).toHaveLength(1);
+    expect(stream.lines()).toHaveLength(5);
+  });
+
+  test('samples high-frequency events', () => {
+    const stream = memoryStream();
+    const logger = new Logger({ level: 'debug', stream, sample: { 'tcp.move': 10 } });
+
+    for (let i = 0; i < 25; i++) {
+      logger.debug('tcp.move', { i });
+    }
+    logger.flush();
+    const lines = stream.lines();
+    expect(lines.map(line => line.i)).toEqual([0, 10, 20]);
+    expect(lines[0].sampled).toBe(10);
+  });
+
+  test('silent writes nothing', () => {
+    const stream = memoryStream();
+    const logger = new Logger({ level: 'silent', stream });
+    logger.error('tcp.error', {});
+    logger.flush();
+    expect(stream.chunks).toHaveLength(0);
+  });
+});
@@ -0,0 +1,40 @@
+const ReconnectCache = require('../src/reconnect_cache');
+
+describe('ReconnectCache', () => {
+  test('counts hits and misses', () => {
+    const cache = new ReconnectCache(4, 1000);
+    cache.set('Alice', 'a', 0);
+
+    expect(cache.get('Alice', 10)).toBe('a');
+    expect(cache.get('Bob', 10)).toBeNull();
+    expect(cache.has('Alice', 10)).toBe(true);
+    expect(cache.stats()).toMatchObject({ size: 1, hits: 1, misses: 1, evictions: 0 });
+  });
+
+  test('evicts the least recently stored entry when full', () => {
+    const cache = new ReconnectCache(2, 1000);
+    cache.set('Alice', 'a', 0);
+    cache.set('Bob', 'b', 1);
+    cache.set('Alice', 'a2', 2); // Re-storing moves Alice to the back
+    cache.set('Carol', 'c', 3);
+
+    expect(cache.size).toBe(2);
+    expect(cache.get('Bob', 4)).toBeNull();
+    expect(cache.get('Alice', 4)).toBe('a2');
+    expect(cache.get('Carol', 4)).toBe('c');
+    expect(cache.stats().evictions).toBe(1);
+  });
+
+  test('expires entries past their TTL', () => {
+    const cache = new ReconnectCache(8, 100);
+    cache.set('Alice', 'a', 0);
+    cache.set('Bob', 'b', 50);
+
+    // Expired but not yet swept: a miss all the same
+    expect(cache.get('Alice', 100)).toBeNull();
+    expect(cache.expire(100)).toBe(1);
+    expect(cache.has('Bob', 100)).toBe(true);
+    expect(cache.expire(150)).toBe(1);
+    expect(cache.stats()).toMatchObject({ size: 0, expirations: 2 });
+  });
+});
@@ -0,0 +1,37 @@
+/**
+ * TCP Receive Buffer Tests
+ */
+
+const RxBuffer = require('../src/rx_buffer');
+
+describe('RxBuffer', () => {
+  test('reads bytes and strings in place', () => {
+    const rx = new RxBuffer(16);
+    rx.append(Buffer.from([0x01, 0x03]));
+    rx.append(Buffer.from('Bob'));
+
+    expect(rx.length).toBe(5);
+    expect(rx.byteAt(0)).toBe(0x01);
+    expect(rx.toString(2, rx.byteAt(1))).toBe('Bob');
+
+    rx.consume(5);
+    expect(rx.length).toBe(0);
+  });
+
+  test('compacts unread bytes when the tail fills up', () => {
+    const rx = new RxBuffer(8);
+    expect(rx.append(Buffer.from([1, 2, 3, 4, 5, 6]))).toBe(6);
+    rx.consume(5);
+
+    expect(rx.append(Buffer.from([7, 8, 9, 10]))).toBe(2);
+    expect(rx.append(Buffer.from([9, 10]))).toBe(2);
+    expect(rx.length).toBe(5);
+    expect([0, 1, 2, 3, 4].map(i => rx.byteAt(i))).toEqual([6, 7, 8, 9, 10]);
+  });
+
+  test('reports a full buffer by copying nothing', () => {
+    const rx = new RxBuffer(4);
+    expect(rx.append(Buffer.from([1, 2, 3, 4, 5]))).toBe(4);
+    expect(rx.append(Buffer.from([5]))).toBe(0);
+  });
+});
@@ -0,0 +1,146 @@
+/**
+ * Simulation Loop Tests
+ */
+
+const World = require('../src/world');
+const Player = require('../src/player');
+const Mob = require('../src/mob');
+const Simulation = require('../src/simulation');
+
+describe('Simulation', () => {
+  let world;
+  let logSpy;
+
+  beforeAll(() => {
+    logSpy = jest.spyOn(console, 'log').mockImplementation(() => {});
+  });
+
+  afterAll(() => {
+    logSpy.mockRestore();
+  });
+
+  beforeEach(() => {
+    world = new World(40, 20);
+  });
+
+  test('getState does not advance the world', () => {
+    world.addMob(new Mob('m1', 'Goblin1', 5, 5));
+    world.getState();
+    world.getState();
+    expect(world.ticks).toBe(0);
+  });
+
+  test('advance runs one step per elapsed tick period', () => {
+    const simulation = new Simulation(world, { tickRate: 10 });
+    simulation.lastTime = 1000;
+
+    expect(simulation.advance(1050)).toBe(0);
+    expect(simulation.advance(1100)).toBe(1);
+    expect(simulation.advance(1350)).toBe(2);
+    expect(world.ticks).toBe(3);
+  });
+
+  test('caps catch-up after a long stall', () => {
+    const simulation = new Simulation(world, { tickRate: 10, maxCatchUpTicks: 5 });
+    simulation.lastTime = 0;
+
+    expect(simulation.advance(10000)).toBe(5);
+    expect(simulation.advance(10100)).toBe(1);
+  });
+
+  test('respawns mobs on the respawn interval', () => {
+    const simulation = new Simulation(world, { tickRate: 10, respawnIntervalMs: 1000, minMobs: 3 });
+    simulation.start();
+    for (let i = 0; i < 9; i++) {
+      simulation.step();
+    }
+    expect(world.mobs.size).toBe(0);
+    simulation.step();
+    expect(world.mobs.size).toBe(3);
+    simulation.stop();
+  });
+
+  test('stopping cancels the respawn timer', () => {
+    const simulation = new Simulation(world, { tickRate: 10, respawnIntervalMs: 1000, minMobs: 3 });
+    simulation.start();
+    simulation.stop();
+    expect(world.timers.size).toBe(0);
+    for (let i = 0; i < 10; i++) {
+      simulation.step();
+    }
+    expect(world.mobs.size).toBe(0);
+  });
+
+  test('expires kill messages during ticks', () => {
+    const simulation = new Simulation(world, { tickRate: 10 });
+    world.setJoinMessage('Alice');
+
+    for (let i = 0; i < 39; i++) {
+      simulation.step();
+    }
+    expect(world.getState().lastKillMessage).toBe('Alice joined the game!');
+    simulation.step();
+    expect(world.getState().lastKillMessage).toBe('');
+  });
+
+  test('a new message restarts the expiry', () => {
+    const simulation = new Simulation(world, { tickRate: 10 });
+    world.setJoinMessage('Alice');
+    for (let i = 0; i < 30; i++) {
+      simulation.step();
+    }
+    world.setJoinMessage('Bob');
+    for (let i = 0; i < 30; i++) {
+      simulation.step();
+    }
+    expect(world.getState().lastKillMessage).toBe('Bob joined the game!');
+  });
+
+  test('drops players whose inactivity deadline passes', () => {
+    const simulation = new Simulation(world, { tickRate: 10, inactiveTimeoutMs: 1000 });
+    world.addPlayer(new Player('p1', 'Alice', 1, 1));
+    world.addPlayer(new Player('p2', 'Bob', 2, 2));
+
+    for (let i = 0; i < 5; i++) {
+      simulation.step();
+    }
+    world.updatePlayerActivity('p2'); // Pushes Bob's deadline back
+    for (let i = 0; i < 5; i++) {
+      simulation.step();
+    }
+    expect(world.getPlayer('p1')).toBeNull();
+    expect(world.getPlayer('p2')).not.toBeNull();
+    expect(world.getDisconnectedPlayer('Alice')).not.toBeNull();
+
+    for (let i = 0; i < 5; i++) {
+      simulation.step();
+    }
+    expect(world.getPlayerCount()).toBe(0);
+    expect(world.timers.size).toBe(0);
+  });
+
+  test('keeps the world inactivity timeout and pending timers in step with its tick rate', () => {
+    const custom = new World(40, 20, { inactiveTimeoutMs: 500 });
+    custom.addPlayer(new Player('p1', 'Alice', 1, 1)); // Due in 5 ticks of 100 ms
+    const simulation = new Simulation(custom, { tickRate: 20 });
+    expect(custom.inactiveTimeoutMs).toBe(500);
+
+    for (let i = 0; i < 9; i++) {
+      simulation.step();
+    }
+    expect(custom.getPlayer('p1')).not.toBeNull();
+    simulation.step(); // 10 ticks of 50 ms
+    expect(custom.getPlayer('p1')).toBeNull();
+  });
+
+  test('notifies tick listeners after each step', () => {
+    const simulation = new Simulation(world);
+    const seen = [];
+    simulation.onTick(ticks => seen.push(ticks));
+    world.addPlayer(new Player('p1', 'Alice', 1, 1));
+
+    simulation.step();
+    simulation.step();
+    expect(seen).toEqual([1, 2]);
+  });
+});
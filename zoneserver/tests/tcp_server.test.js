@@ -11,8 +11,17 @@ function buildJoinPacket(name) {
   ]);
 }
 
+function buildViewJoinPacket(name, viewW, viewH, flags = 0) {
+  const nameBuf = Buffer.from(name);
+  return Buffer.concat([
+    Buffer.from([0x08, flags, viewW, viewH, nameBuf.length]),
+    nameBuf
+  ]);
+}
+
 function parseJoinResponse(buf) {
-  let offset = 0;
+  const frameLen = buf.readUInt16LE(0);
+  let offset = 2;
   const type = buf.readUInt8(offset++);
   const idLen = buf.readUInt8(offset++);
   const id = buf.slice(offset, offset + idLen).toString();
@@ -23,12 +32,14 @@ function parseJoinResponse(buf) {
   const verLen = buf.readUInt8(offset++);
   const version = buf.slice(offset, offset + verLen).toString();
 
-  return { type, idLen, id, x, y, health, verLen, version, totalLen: 1 + 1 + idLen + 1 + 1 + 1 + 1 + verLen };
+  return { type, idLen, id, x, y, health, verLen, version, frameLen, totalLen: offset + verLen };
 }
 
 function parseMoveResponse(buf) {
-  let offset = 0;
+  const frameLen = buf.readUInt16LE(0);
+  let offset = 2;
   const type = buf.readUInt8(offset++);
+  const seq = type === 0x06 ? buf.readUInt8(offset++) : null; // Sequenced move
   const x = buf.readUInt8(offset++);
   const y = buf.readUInt8(offset++);
   const health = buf.readUInt8(offset++);
@@ -42,6 +53,7 @@ function parseMoveResponse(buf) {
 
   return {
     type,
+    seq,
     x,
     y,
     health,
@@ -50,12 +62,14 @@ function parseMoveResponse(buf) {
     message,
     loserIdLen,
     loserId,
+    frameLen,
     totalLen: offset
   };
 }
 
 function parseStateResponse(buf) {
-  let offset = 0;
+  const frameLen = buf.readUInt16LE(0);
+  let offset = 2;
   const type = buf.readUInt8(offset++);
   const count = buf.readUInt8(offset++);
   const ticksLow = buf.readUInt8(offset++);
@@ -77,10 +91,51 @@ function parseStateResponse(buf) {
     msgLen,
     message,
     entities,
+    frameLen,
     totalLen: offset
   };
 }
 
+function parseDeltaResponse(buf) {
+  const frameLen = buf.readUInt16LE(0);
+  let offset = 2;
+  const type = buf.readUInt8(offset++);
+  const flags = buf.readUInt8(offset++);
+  const ticksLow = buf.readUInt8(offset++);
+  const ticksHigh = buf.readUInt8(offset++);
+  const msgLen = buf.readUInt8(offset++);
+  const message = buf.slice(offset, offset + msgLen).toString();
+  offset += msgLen;
+  const removedCount = buf.readUInt8(offset++);
+  const removed = [];
+  for (let i = 0; i < removedCount; i++) {
+    removed.push(buf.readUInt8(offset++));
+  }
+  const upsertCount = buf.readUInt8(offset++);
+  const upserts = [];
+  for (let i = 0; i < upsertCount; i++) {
+    const handle = buf.readUInt8(offset++);
+    const typeChar = String.fromCharCode(buf.readUInt8(offset++));
+    const x = buf.readUInt8(offset++);
+    const y = buf.readUInt8(offset++);
+    upserts.push({ handle, typeChar, x, y });
+  }
+  return {
+    type,
+    full: (flags & 0x01) !== 0,
+    ticks: (ticksHigh << 8) | ticksLow,
+    message,
+    removed,
+    upserts,
+    frameLen,
+    totalLen: offset
+  };
+}
+
+function buildDeltaPacket(ackTicks, flags = 0) {
+  return Buffer.from([0x04, flags, ackTicks & 0xFF, (ackTicks >> 8) & 0xFF]);
+}
+
 function waitForData(socket, timeoutMs = 500) {
   return new Promise((resolve, reject) => {
     const timer = setTimeout(() => {
@@ -137,8 +192,8 @@ function waitForNoData(socket, timeoutMs = 150) {
   });
 }
 
-async function createServerAndClient() {
-  const world = new World(40, 20);
+async function createServerAndClient(width = 40, height = 20) {
+  const world = new World(width, height);
   const tcpServer = new TcpServer(world, 0);
   tcpServer.start();
   await once(tcpServer.server, 'listening');
@@ -204,6 +259,7 @@ describe('TCP Server Protocol', () => {
     expect(joinResp.health).toBe(100);
     expect(joinResp.verLen).toBeGreaterThan(0);
     expect(joinResp.version.length).toBe(joinResp.verLen);
+    expect(joinResp.frameLen + 2).toBe(joinResp.totalLen);
     expect(world.getPlayerCount()).toBe(1);
   });
 
@@ -221,17 +277,18 @@ describe('TCP Server Protocol', () => {
     client.write(Buffer.from([0x02, 'u'.charCodeAt(0), 0x03]));
 
     let combined = await waitForData(client);
-    if (combined.length < 7) {
+    if (combined.length < 9) {
       combined = Buffer.concat([combined, await waitForData(client)]);
     }
 
     const moveResp = parseMoveResponse(combined);
     expect(moveResp.type).toBe(0x02);
     expect(moveResp.loserIdLen).toBe(0);
-    expect(moveResp.totalLen).toBe(7);
+    expect(moveResp.totalLen).toBe(9);
+    expect(moveResp.frameLen).toBe(moveResp.totalLen - 2);
 
     let stateBuf = combined.slice(moveResp.totalLen);
-    if (stateBuf.length < 5) {
+    if (stateBuf.length < 7) {
       stateBuf = Buffer.concat([stateBuf, await waitForData(client)]);
     }
     const stateResp = parseStateResponse(stateBuf);
@@ -297,6 +354,19 @@ describe('TCP Server Protocol', () => {
     expect(world.getPlayerCount()).toBe(1);
   });
 
+  test('parses a burst larger than the receive buffer in one data event', async () => {
+    const { world, tcpServer, client } = await createServerAndClient();
+    sockets.push(client);
+    servers.push(tcpServer.server);
+
+    const junk = Buffer.alloc(3000, 0x7f);
+    client.write(Buffer.concat([junk, buildJoinPacket('BurstUser')]));
+
+    const joinResp = parseJoinResponse(await waitForData(client, 1000));
+    expect(joinResp.type).toBe(0x01);
+    expect(world.getPlayerCount()).toBe(1);
+  });
+
   test('rejects oversized join name length by closing socket', async () => {
     const { tcpServer, client } = await createServerAndClient();
     sockets.push(client);
@@ -310,4 +380,440 @@ describe('TCP Server Protocol', () => {
       waitForData(client, 250).then(() => 'data')
     ])).resolves.toBe('closed');
   });
+
+  test('delta state sends a full snapshot first, then only changes', async () => {
+    const { world, tcpServer, client } = await createServerAndClient();
+    sockets.push(client);
+    servers.push(tcpServer.server);
+
+    const Mob = require('../src/mob');
+    const still = new Mob('m_still', 'Goblin1', 5, 5);
+    const mover = new Mob('m_mover', 'Goblin2', 10, 10);
+    const doomed = new Mob('m_doomed', 'Goblin3', 15, 15);
+    for (const mob of [still, mover, doomed]) {
+      mob.moveInterval = Infinity; // Keep ticks from wandering the mobs
+      world.addMob(mob);
+    }
+
+    client.write(buildJoinPacket('DeltaUser'));
+    parseJoinResponse(await waitForData(client));
+    world.tick();
+
+    client.write(buildDeltaPacket(0));
+    const first = parseDeltaResponse(await waitForData(client));
+    expect(first.type).toBe(0x04);
+    expect(first.full).toBe(true);
+    expect(first.upserts.length).toBe(4);
+    expect(first.upserts.filter(u => u.typeChar === 'M').length).toBe(1);
+
+    mover.setPosition(11, 10);
+    const doomedHandle = doomed.handle;
+    world.removeMob('m_doomed');
+    world.tick();
+
+    client.write(buildDeltaPacket(first.ticks));
+    const second = parseDeltaResponse(await waitForData(client));
+    expect(second.full).toBe(false);
+    expect(second.removed).toEqual([doomedHandle]);
+    expect(second.upserts.length).toBe(1);
+    expect(second.upserts[0].handle).toBe(mover.handle);
+    expect(second.upserts[0].x).toBe(11);
+
+    world.tick();
+    client.write(buildDeltaPacket(second.ticks));
+    const idle = parseDeltaResponse(await waitForData(client));
+    expect(idle.full).toBe(false);
+    expect(idle.removed.length).toBe(0);
+    expect(idle.upserts.length).toBe(0);
+    expect(idle.totalLen).toBe(9);
+    expect(idle.frameLen).toBe(7);
+  });
+
+  test('move-with-delta replies with the move result and the world changes together', async () => {
+    const { world, tcpServer, client } = await createServerAndClient();
+    sockets.push(client);
+    servers.push(tcpServer.server);
+
+    const Mob = require('../src/mob');
+    const mob = new Mob('m_near', 'Goblin1', 30, 15);
+    mob.moveInterval = Infinity;
+    world.addMob(mob);
+
+    client.write(buildJoinPacket('StepUser'));
+    const join = parseJoinResponse(await waitForData(client));
+    const player = world.getPlayer(join.id);
+    player.setPosition(5, 5);
+    world.clearKillMessage();
+    world.tick();
+
+    client.write(buildDeltaPacket(0));
+    const first = parseDeltaResponse(await waitForData(client));
+
+    mob.setPosition(29, 15);
+    world.tick();
+
+    client.write(Buffer.from([0x06, 42, 'r'.charCodeAt(0), 0x00, first.ticks & 0xFF, first.ticks >> 8]));
+    let reply = await waitForData(client);
+    const move = parseMoveResponse(reply);
+    while (reply.length <= move.totalLen) {
+      reply = Buffer.concat([reply, await waitForData(client)]);
+    }
+    const delta = parseDeltaResponse(reply.slice(move.totalLen));
+
+    expect(move.type).toBe(0x06);
+    expect(move.seq).toBe(42);
+    expect(move.x).toBe(6);
+    expect(delta.type).toBe(0x04);
+    expect(delta.full).toBe(false);
+    expect(delta.upserts.find(u => u.handle === mob.handle)).toEqual({ handle: mob.handle, typeChar: 'E', x: 29, y: 15 });
+    expect(delta.upserts.find(u => u.handle === player.handle)).toEqual({ handle: player.handle, typeChar: 'M', x: 6, y: 5 });
+  });
+
+  test('batched moves apply in order with per-step results and one delta', async () => {
+    const { world, tcpServer, client } = await createServerAndClient();
+    sockets.push(client);
+    servers.push(tcpServer.server);
+
+    const Mob = require('../src/mob');
+    const blocker = new Mob('m_block', 'Goblin1', 8, 5);
+    blocker.moveInterval = Infinity;
+    blocker.health = 1;
+    world.addMob(blocker);
+
+    client.write(buildJoinPacket('BurstUser'));
+    const join = parseJoinResponse(await waitForData(client));
+    const player = world.getPlayer(join.id);
+    player.setPosition(5, 5);
+
+    // right, right, right (into the goblin), down: nibbles 3,3 / 3,1
+    client.write(Buffer.from([0x07, 9, 4, 0x01, 0x00, 0x00, 0x33, 0x13]));
+    let reply = await waitForData(client);
+    while (reply.length < 2 || reply.length <= reply.readUInt16LE(0) + 2) {
+      reply = Buffer.concat([reply, await waitForData(client)]);
+    }
+
+    let offset = 2;
+    expect(reply[offset++]).toBe(0x07);
+    expect(reply[offset++]).toBe(9);
+    const count = reply[offset++];
+    const steps = [];
+    for (let i = 0; i < count; i++) {
+      const step = { x: reply[offset++], y: reply[offset++], health: reply[offset++], collision: reply[offset++] };
+      const msgLen = reply[offset++];
+      step.message = reply.slice(offset, offset + msgLen).toString();
+      offset += msgLen;
+      offset += 1 + reply[offset];
+      steps.push(step);
+    }
+
+    expect(count).toBe(4);
+    expect(steps[0]).toMatchObject({ x: 6, y: 5, collision: 0 });
+    expect(steps[1]).toMatchObject({ x: 7, y: 5, collision: 0 });
+    expect(steps[2].collision).toBe(1);
+    expect(steps[2].message).toMatch(/defeats/);
+    expect(steps[3]).toMatchObject({ x: 7, y: 6, collision: 0 });
+
+    const delta = parseDeltaResponse(reply.slice(offset));
+    expect(delta.type).toBe(0x04);
+    expect(delta.full).toBe(true);
+  });
+
+  test('rejects an oversized move batch', async () => {
+    const { tcpServer, client } = await createServerAndClient();
+    sockets.push(client);
+    servers.push(tcpServer.server);
+
+    client.write(buildJoinPacket('GreedyUser'));
+    await waitForData(client);
+
+    client.write(Buffer.from([0x07, 1, 9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00]));
+    await once(client, 'close');
+  });
+
+  test('delta state falls back to a full snapshot when the baseline is too old', async () => {
+    const { world, tcpServer, client } = await createServerAndClient();
+    sockets.push(client);
+    servers.push(tcpServer.server);
+
+    client.write(buildJoinPacket('StaleUser'));
+    parseJoinResponse(await waitForData(client));
+
+    client.write(buildDeltaPacket(0));
+    const first = parseDeltaResponse(await waitForData(client));
+    expect(first.full).toBe(true);
+
+    for (let i = 0; i < world.delta.historyTicks + 5; i++) {
+      world.tick();
+    }
+
+    client.write(buildDeltaPacket(first.ticks));
+    const stale = parseDeltaResponse(await waitForData(client));
+    expect(stale.full).toBe(true);
+    expect(stale.upserts.length).toBe(world.players.size + world.mobs.size);
+  });
+
+  test('subscribed sockets get pushed deltas only when the world changes', async () => {
+    const { world, tcpServer, client } = await createServerAndClient();
+    sockets.push(client);
+    servers.push(tcpServer.server);
+
+    const Mob = require('../src/mob');
+    const mob = new Mob('m_push', 'Goblin1', 3, 3);
+    mob.moveInterval = Infinity;
+    world.addMob(mob);
+
+    client.write(buildJoinPacket('PushUser'));
+    parseJoinResponse(await waitForData(client));
+
+    client.write(Buffer.from([0x05, 0x01]));
+    const snapshot = parseDeltaResponse(await waitForData(client));
+    expect(snapshot.full).toBe(true);
+    expect(snapshot.upserts.length).toBe(2);
+
+    // The first push re-sends changes made between ticks (join, subscribe)
+    world.tick();
+    tcpServer.pushUpdates();
+    await waitForData(client);
+
+    world.tick();
+    tcpServer.pushUpdates();
+    await waitForNoData(client, 100);
+
+    mob.setPosition(4, 3);
+    world.tick();
+    tcpServer.pushUpdates();
+    const pushed = parseDeltaResponse(await waitForData(client));
+    expect(pushed.full).toBe(false);
+    expect(pushed.upserts).toEqual([{ handle: mob.handle, typeChar: 'E', x: 4, y: 3 }]);
+
+    client.write(Buffer.from([0x05, 0x00]));
+    await new Promise(resolve => setTimeout(resolve, 20));
+    mob.setPosition(5, 3);
+    world.tick();
+    tcpServer.pushUpdates();
+    await waitForNoData(client, 100);
+  });
+
+  test('one pushed frame is shared, with each recipient seeing itself as M', async () => {
+    const { world, tcpServer, client } = await createServerAndClient();
+    const { port } = tcpServer.server.address();
+    const other = net.createConnection({ port, host: '127.0.0.1' });
+    await once(other, 'connect');
+    sockets.push(client, other);
+    servers.push(tcpServer.server);
+
+    client.write(buildJoinPacket('Alice'));
+    parseJoinResponse(await waitForData(client));
+    other.write(buildJoinPacket('Bob'));
+    parseJoinResponse(await waitForData(other));
+
+    client.write(Buffer.from([0x05, 0x01]));
+    await waitForData(client);
+    other.write(Buffer.from([0x05, 0x01]));
+    await waitForData(other);
+
+    world.tick();
+    const firstPush = Promise.all([waitForData(client), waitForData(other)]);
+    tcpServer.pushUpdates();
+    await firstPush;
+
+    const alice = Array.from(world.players.values()).find(p => p.name === 'Alice');
+    const bob = Array.from(world.players.values()).find(p => p.name === 'Bob');
+    alice.setPosition(1, 1);
+    bob.setPosition(2, 2);
+    world.tick();
+    const pushed = Promise.all([waitForData(client), waitForData(other)]);
+    tcpServer.pushUpdates();
+
+    const [aliceBuf, bobBuf] = await pushed;
+    const seenByAlice = parseDeltaResponse(aliceBuf);
+    const seenByBob = parseDeltaResponse(bobBuf);
+    const typeOf = (frame, player) => frame.upserts.find(u => u.handle === player.handle).typeChar;
+    expect(typeOf(seenByAlice, alice)).toBe('M');
+    expect(typeOf(seenByAlice, bob)).toBe('P');
+    expect(typeOf(seenByBob, alice)).toBe('P');
+    expect(typeOf(seenByBob, bob)).toBe('M');
+  });
+
+  test('viewport clients only hear about entities entering and leaving their view', async () => {
+    const { world, tcpServer, client } = await createServerAndClient();
+    sockets.push(client);
+    servers.push(tcpServer.server);
+
+    const Mob = require('../src/mob');
+    const near = new Mob('m_near', 'Goblin1', 7, 5);
+    const far = new Mob('m_far', 'Goblin2', 30, 15);
+    near.moveInterval = Infinity;
+    far.moveInterval = Infinity;
+    world.addMob(near);
+    world.addMob(far);
+
+    client.write(buildViewJoinPacket('Viewer', 10, 6));
+    const join = parseJoinResponse(await waitForData(client));
+    expect(join.type).toBe(0x01);
+    world.getPlayer(join.id).setPosition(5, 5); // View spans x 0-9, y 2-7
+
+    client.write(Buffer.from([0x05, 0x01]));
+    const snapshot = parseDeltaResponse(await waitForData(client));
+    expect(snapshot.full).toBe(true);
+    expect(snapshot.upserts.map(u => u.typeChar)).toEqual(['M', 'E']);
+    expect(snapshot.upserts[1]).toMatchObject({ typeChar: 'E', x: 7, y: 5 });
+    const nearHandle = snapshot.upserts[1].handle;
+
+    // The first push re-sends changes made between ticks (join, subscribe)
+    world.tick();
+    const first = waitForData(client);
+    tcpServer.pushUpdates();
+    await first;
+
+    // Changes outside the view stay silent
+    far.setPosition(31, 15);
+    world.tick();
+    tcpServer.pushUpdates();
+    await waitForNoData(client, 100);
+
+    far.setPosition(8, 6);
+    near.setPosition(35, 18);
+    world.tick();
+    const pushed = waitForData(client);
+    tcpServer.pushUpdates();
+    const delta = parseDeltaResponse(await pushed);
+    expect(delta.full).toBe(false);
+    expect(delta.removed).toEqual([nearHandle]);
+    expect(delta.upserts).toHaveLength(1);
+    expect(delta.upserts[0]).toMatchObject({ typeChar: 'E', x: 8, y: 6 });
+    expect(delta.upserts[0].handle).not.toBe(nearHandle);
+  });
+
+  test('viewport clients see entities beyond the first 255 in the world', async () => {
+    const { world, tcpServer, client } = await createServerAndClient(100, 100);
+    sockets.push(client);
+    servers.push(tcpServer.server);
+
+    const Mob = require('../src/mob');
+    for (let i = 0; i < 300; i++) {
+      const mob = new Mob(`m_${i}`, 'Goblin', i % 100, Math.floor(i / 100));
+      mob.moveInterval = Infinity;
+      world.addMob(mob);
+    }
+    const late = world.getMob('m_299');
+    expect(late.handle).toBe(0); // The world-wide pool ran out
+
+    client.write(buildViewJoinPacket('Late', 10, 6));
+    const join = parseJoinResponse(await waitForData(client));
+    world.getPlayer(join.id).setPosition(99, 50);
+
+    client.write(Buffer.from([0x05, 0x01]));
+    const snapshot = parseDeltaResponse(await waitForData(client));
+    expect(snapshot.upserts.map(u => u.typeChar)).toEqual(['M']);
+
+    // Walk into the corner where the last mobs stand
+    world.getPlayer(join.id).setPosition(97, 4);
+    world.tick();
+    tcpServer.pushUpdates();
+    const delta = parseDeltaResponse(await waitForData(client));
+    const seen = delta.upserts.filter(u => u.typeChar === 'E');
+    expect(seen.find(u => u.x === 99 && u.y === 2)).toBeDefined();
+    expect(seen.every(u => u.handle > 0)).toBe(true);
+    expect(new Set(delta.upserts.map(u => u.handle)).size).toBe(delta.upserts.length);
+  });
+
+  test('a crowded viewport keeps only the nearest entities', async () => {
+    const { world, tcpServer, client } = await createServerAndClient();
+    sockets.push(client);
+    servers.push(tcpServer.server);
+
+    const Mob = require('../src/mob');
+    for (let i = 0; i < 100; i++) {
+      const mob = new Mob(`m_${i}`, 'Goblin', i % 40, 10 + Math.floor(i / 40));
+      mob.moveInterval = Infinity;
+      world.addMob(mob);
+    }
+
+    client.write(buildViewJoinPacket('Crowd', 40, 20));
+    const join = parseJoinResponse(await waitForData(client));
+    world.getPlayer(join.id).setPosition(20, 0);
+
+    client.write(Buffer.from([0x03]));
+    const state = parseStateResponse(await waitForData(client));
+    expect(state.count).toBe(65);
+    expect(state.entities[0]).toEqual({ typeChar: 'M', x: 20, y: 0 });
+
+    const dist = e => (e.x - 20) * (e.x - 20) + e.y * e.y;
+    const sent = state.entities.slice(1).map(dist);
+    const kept = new Set(state.entities.map(e => `${e.x},${e.y}`));
+    const dropped = Array.from(world.mobs.values()).filter(m => !kept.has(`${m.x},${m.y}`)).map(dist);
+    expect(dropped.length).toBe(100 - 64);
+    expect(Math.max(...sent)).toBeLessThanOrEqual(Math.min(...dropped));
+  });
+
+  test('wide viewport clients get u16 positions on a large map', async () => {
+    const { world, tcpServer, client } = await createServerAndClient(1024, 512);
+    sockets.push(client);
+    servers.push(tcpServer.server);
+
+    const Mob = require('../src/mob');
+    const mob = new Mob('m_wide', 'Goblin1', 700, 301);
+    mob.moveInterval = Infinity;
+    world.addMob(mob);
+
+    client.write(buildViewJoinPacket('Wide', 40, 20, 0x01));
+    const buf = await waitForData(client);
+    let offset = 3;
+    const idLen = buf.readUInt8(offset++);
+    const id = buf.slice(offset, offset + idLen).toString();
+    offset += idLen + 4 + 1; // X16 Y16 Health
+    expect(buf.readUInt16LE(offset)).toBe(1024);
+    expect(buf.readUInt16LE(offset + 2)).toBe(512);
+
+    world.getPlayer(id).setPosition(698, 300);
+    client.write(Buffer.from([0x05, 0x01]));
+    const frame = await waitForData(client);
+    offset = 2;
+    expect(frame.readUInt8(offset)).toBe(0x04);
+    offset += 5 + frame.readUInt8(offset + 4); // Type Flags Ticks MsgLen Msg
+    expect(frame.readUInt8(offset++)).toBe(0); // Removed
+    expect(frame.readUInt8(offset++)).toBe(2); // Upserts
+    const upserts = [];
+    for (let i = 0; i < 2; i++, offset += 6) {
+      upserts.push({
+        typeChar: String.fromCharCode(frame.readUInt8(offset + 1)),
+        x: frame.readUInt16LE(offset + 2),
+        y: frame.readUInt16LE(offset + 4)
+      });
+    }
+    expect(upserts).toEqual([
+      { typeChar: 'M', x: 698, y: 300 },
+      { typeChar: 'E', x: 700, y: 301 }
+    ]);
+    expect(offset).toBe(frame.length);
+  });
+
+  test('joinZone reads the zone byte of a 0x08 join without consuming it', () => {
+    const zoned = Buffer.concat([buildViewJoinPacket('Zed', 40, 20, 0x03), Buffer.from([5])]);
+    expect(TcpServer.joinZone(zoned)).toBe(5);
+    expect(TcpServer.joinZone(zoned.slice(0, zoned.length - 1))).toBeUndefined();
+    expect(TcpServer.joinZone(zoned.slice(0, 3))).toBeUndefined();
+    expect(TcpServer.joinZone(Buffer.alloc(0))).toBeUndefined();
+    expect(TcpServer.joinZone(buildViewJoinPacket('Zed', 40, 20))).toBeNull();
+    expect(TcpServer.joinZone(buildJoinPacket('Zed'))).toBeNull();
+  });
+
+  test('0x08 join with a zone byte is accepted by a single server', async () => {
+    const { world, tcpServer, client } = await createServerAndClient();
+    sockets.push(client);
+    servers.push(tcpServer.server);
+
+    client.write(Buffer.concat([buildViewJoinPacket('Zoned', 10, 6, 0x02), Buffer.from([3]), Buffer.from([0x03])]));
+    let buf = await waitForData(client);
+    expect(buf.readUInt8(2)).toBe(0x01);
+    expect(world.getPlayerCount()).toBe(1);
+
+    // The zone byte was consumed with the join, so the 0x03 after it parses
+    const joinLen = 2 + buf.readUInt16LE(0);
+    if (buf.length === joinLen) {
+      buf = Buffer.concat([buf, await waitForData(client)]);
+    }
+    expect(buf.readUInt8(joinLen + 2)).toBe(0x03);
+  });
 });
@@ -0,0 +1,64 @@
+const TimerWheel = require('../src/timer_wheel');
+
+describe('TimerWheel', () => {
+  test('fires timers on their deadline tick', () => {
+    const wheel = new TimerWheel();
+    const fired = [];
+    for (const delay of [1, 63, 64, 65, 4095, 4096, 5000, 300000]) {
+      wheel.schedule(delay, tick => fired.push([delay, tick]));
+    }
+
+    expect(wheel.advance(300000)).toBe(8);
+    expect(fired.map(([delay, tick]) => delay === tick)).toEqual(new Array(8).fill(true));
+    expect(wheel.size).toBe(0);
+  });
+
+  test('cancelled and rescheduled timers', () => {
+    const wheel = new TimerWheel(100);
+    const fired = [];
+    const a = wheel.schedule(10, tick => fired.push(['a', tick]));
+    const b = wheel.schedule(10, tick => fired.push(['b', tick]));
+    expect(wheel.cancel(a)).toBe(true);
+    expect(wheel.cancel(a)).toBe(false);
+
+    wheel.advance(105);
+    wheel.reschedule(b, 200); // Due at 305
+    wheel.advance(304);
+    expect(fired).toEqual([]);
+    wheel.advance(305);
+    expect(fired).toEqual([['b', 305]]);
+  });
+
+  test('rescaling stretches pending delays and intervals', () => {
+    const wheel = new TimerWheel(10);
+    const fired = [];
+    wheel.schedule(20, tick => fired.push(['once', tick]));
+    wheel.every(5, tick => fired.push(['every', tick]));
+
+    wheel.rescale(2); // Ticks are now half as long
+    wheel.advance(60);
+    expect(fired).toEqual([['every', 20], ['every', 30], ['every', 40], ['once', 50], ['every', 50], ['every', 60]]);
+  });
+
+  test('repeating timers', () => {
+    const wheel = new TimerWheel();
+    const fired = [];
+    wheel.every(50, tick => fired.push(tick));
+
+    wheel.advance(200);
+    expect(fired).toEqual([50, 100, 150, 200]);
+    expect(wheel.size).toBe(1);
+  });
+
+  test('deadlines beyond the wheel span', () => {
+    const wheel = new TimerWheel();
+    let firedAt = 0;
+    const span = Math.pow(64, 4);
+    wheel.schedule(span + 10, tick => { firedAt = tick; });
+
+    wheel.advance(span + 9);
+    expect(firedAt).toBe(0);
+    wheel.advance(span + 10);
+    expect(firedAt).toBe(span + 10);
+  });
+});
@@ -4,6 +4,7 @@
 
 const World = require('../src/world');
 const Player = require('../src/player');
+const Mob = require('../src/mob');
 
 describe('World', () => {
   let world;
@@ -126,6 +127,102 @@ describe('World', () => {
     });
   });
 
+  describe('spatial index', () => {
+    test('tracks player moves made through setPosition', () => {
+      const player = new Player('p1', 'Alice', 10, 10);
+      world.addPlayer(player);
+
+      player.setPosition(11, 10);
+      expect(world.getPlayerAtPosition(10, 10)).toBeNull();
+      expect(world.getPlayerAtPosition(11, 10)).toBe(player);
+    });
+
+    test('finds mobs and keeps them separate from players', () => {
+      const player = new Player('p1', 'Alice', 5, 5);
+      const mob = new Mob('m1', 'Goblin1', 5, 5);
+      world.addPlayer(player);
+      world.addMob(mob);
+
+      expect(world.getPlayerAtPosition(5, 5)).toBe(player);
+      expect(world.getMobAtPosition(5, 5)).toBe(mob);
+
+      mob.setPosition(6, 5);
+      expect(world.getMobAtPosition(5, 5)).toBeNull();
+      expect(world.getMobAtPosition(6, 5)).toBe(mob);
+    });
+
+    test('drops removed entities from the index', () => {
+      const player = new Player('p1', 'Alice', 3, 4);
+      const mob = new Mob('m1', 'Goblin1', 7, 8);
+      world.addPlayer(player);
+      world.addMob(mob);
+
+      world.removePlayer('p1');
+      world.removeMob('m1');
+      expect(world.getPlayerAtPosition(3, 4)).toBeNull();
+      expect(world.getMobAtPosition(7, 8)).toBeNull();
+
+      // Disconnected players no longer update the index
+      player.setPosition(1, 1);
+      expect(world.getPlayerAtPosition(1, 1)).toBeNull();
+    });
+
+    test('collects entities inside a rectangle', () => {
+      const inside = new Player('p1', 'Alice', 2, 3);
+      const edge = new Mob('m1', 'Goblin1', 5, 6);
+      const outside = new Player('p2', 'Bob', 6, 6);
+      world.addPlayer(inside);
+      world.addMob(edge);
+      world.addPlayer(outside);
+
+      const found = world.grid.queryRect(-3, 0, 5, 6);
+      expect(found.length).toBe(2);
+      expect(found).toContain(inside);
+      expect(found).toContain(edge);
+    });
+
+    test('allocates grid chunks only where entities stand on a large map', () => {
+      const big = new World(4096, 4096);
+      const alice = new Player('p1', 'Alice', 10, 10);
+      const bob = new Player('p2', 'Bob', 4000, 3000);
+      big.addPlayer(alice);
+      big.addPlayer(bob);
+      expect(big.grid.chunkCount()).toBe(2);
+      expect(big.getPlayerAtPosition(4000, 3000)).toBe(bob);
+
+      bob.setPosition(11, 10);
+      expect(big.grid.chunkCount()).toBe(1);
+      expect(big.grid.queryRect(0, 0, 4095, 4095)).toEqual([alice, bob]);
+    });
+  });
+
+  describe('delta handles', () => {
+    test('hands a released handle to the oldest entity waiting for one', () => {
+      const mobs = [];
+      for (let i = 0; i < 257; i++) {
+        const mob = new Mob(`m${i}`, 'Goblin', i % 40, Math.floor(i / 40));
+        world.addMob(mob);
+        mobs.push(mob);
+      }
+      expect(mobs[254].handle).toBe(255);
+      expect(mobs[255].handle).toBe(0);
+      expect(mobs[256].handle).toBe(0);
+
+      const freed = mobs[3].handle;
+      world.tick();
+      world.removeMob('m3');
+      expect(mobs[255].handle).toBe(freed);
+      expect(mobs[255].changedTick).toBe(world.ticks + 1);
+      expect(mobs[256].handle).toBe(0);
+      expect(world.delta.removedSince(world.ticks)).toEqual([freed]);
+
+      world.removeMob('m256');
+      world.removeMob('m4');
+      expect(mobs[256].handle).toBe(0);
+      expect(world.delta.freeHandles).toContain(5);
+    });
+  });
+
   describe('world state', () => {
     test('returns world state snapshot', () => {
       const p1 = new Player('p1', 'Alice', 10, 10);
@@ -183,4 +280,147 @@ describe('World', () => {
       expect(world.timestamp).toBeGreaterThanOrEqual(beforeReset);
     });
   });
+
+  describe('kill feed', () => {
+    test('onKill listeners receive kill messages, not announcements', () => {
+      const heard = [];
+      world.onKill(text => heard.push(text));
+
+      world.setKillMessage('Alice', 'Bob', 'player');
+      world.setAnnouncement('[Z1] Carol killed Dave!');
+
+      expect(heard).toEqual(['Alice killed Bob!']);
+      expect(world.lastKillMessage).toBe('[Z1] Carol killed Dave!');
+    });
+  });
+
+  describe('reconnect cache', () => {
+    test('keeps removed players for rejoin within its capacity', () => {
+      const bounded = new World(40, 20, { reconnectCapacity: 2 });
+      for (const name of ['A', 'B', 'C']) {
+        bounded.addPlayer(new Player(`id_${name}`, name, 1, 1));
+        bounded.removePlayer(`id_${name}`);
+      }
+
+      expect(bounded.getDisconnectedPlayer('A')).toBeNull();
+      expect(bounded.getDisconnectedPlayer('C').id).toBe('id_C');
+      expect(bounded.isRejoiningPlayer('B')).toBe(true);
+      expect(bounded.disconnectedPlayers.stats()).toMatchObject({ size: 2, hits: 1, misses: 1, evictions: 1 });
+    });
+
+    test('tick forgets disconnected players past the TTL', () => {
+      const shortLived = new World(40, 20, { reconnectTtlMs: 0 });
+      shortLived.addPlayer(new Player('id_A', 'A', 1, 1));
+      shortLived.removePlayer('id_A');
+      expect(shortLived.disconnectedPlayers.size).toBe(1);
+
+      shortLived.tick();
+      expect(shortLived.disconnectedPlayers.size).toBe(0);
+      expect(shortLived.isRejoiningPlayer('A')).toBe(false);
+    });
+  });
+
+  describe('spawn placement', () => {
+    test('tracks free cells as entities come and go', () => {
+      const small = new World(4, 2);
+      const alice = new Player('p1', 'Alice', 0, 0);
+      small.addPlayer(alice);
+      small.addMob(new Mob('m1', 'Goblin1', 0, 0));
+      expect(small.grid.freeCellCount()).toBe(7);
+
+      alice.setPosition(1, 0);
+      expect(small.grid.freeCellCount()).toBe(6);
+      small.removeMob('m1');
+      small.removePlayer('p1');
+      expect(small.grid.freeCellCount()).toBe(8);
+    });
+
+    test('spawns only on unoccupied cells until the map is full', () => {
+      const small = new World(4, 2);
+      small.addPlayer(new Player('p1', 'Alice', 0, 0));
+
+      const spawned = small.respawnMobs(10);
+      expect(spawned.length).toBe(7);
+      const cells = new Set([...small.getAllPlayers(), ...spawned].map(e => `${e.x},${e.y}`));
+      expect(cells.size).toBe(8);
+      expect(small.findSpawnCell()).toBeNull();
+    });
+
+    test('draws every free cell of a chunked map with equal weight', () => {
+      const big = new World(40, 20); // Chunks 16 wide, the last ones partial
+      for (let x = 0; x < 40; x++) {
+        for (let y = 0; y < 20; y++) {
+          if ((x + y) % 3 !== 0) {
+            big.addMob(new Mob(`m_${x}_${y}`, 'Goblin', x, y));
+          }
+        }
+      }
+      const free = big.grid.freeCellCount();
+      const seen = new Set();
+      for (let k = 0; k < free; k++) {
+        const cell = big.grid.randomFreeCell(() => (k + 0.5) / free);
+        expect((cell.x + cell.y) % 3).toBe(0);
+        seen.add(`${cell.x},${cell.y}`);
+      }
+      expect(seen.size).toBe(free);
+    });
+
+    test('keeps a minimum distance from players when the map allows', () => {
+      // Nine in ten free cells qualify, so a draw of eight all missing is vanishingly rare
+      const field = new World(40, 20, { minSpawnDistance: 5 });
+      field.addPlayer(new Player('p1', 'Alice', 5, 10));
+
+      for (let i = 0; i < 50; i++) {
+        const cell = field.findSpawnCell();
+        expect(Math.max(Math.abs(cell.x - 5), Math.abs(cell.y - 10)) >= 5).toBe(true);
+      }
+    });
+
+    test('falls back to the farthest cell drawn when none is far enough', () => {
+      const field = new World(40, 20, { minSpawnDistance: 50 }); // More than the map allows
+      field.addPlayer(new Player('p1', 'Alice', 0, 0));
+      const draws = [];
+      const randomFreeCell = field.grid.randomFreeCell.bind(field.grid);
+      field.grid.randomFreeCell = () => {
+        const drawn = randomFreeCell();
+        draws.push(drawn);
+        return drawn;
+      };
+
+      const cell = field.findSpawnCell();
+      expect(draws.length).toBe(8);
+      const farthest = Math.max(...draws.map(drawn => Math.max(drawn.x, drawn.y)));
+      expect(Math.max(cell.x, cell.y)).toBe(farthest);
+    });
+  });
+
+  describe('hunters', () => {
+    test('respawn keeps up the requested number of hunters', () => {
+      const spawned = world.respawnMobs(10, 4);
+      expect(spawned.filter(mob => mob.isHunter)).toHaveLength(4);
+
+      world.removeMob(spawned[0].id);
+      const refill = world.respawnMobs(10, 4);
+      expect(refill).toHaveLength(1);
+      expect(refill[0].isHunter).toBe(true);
+    });
+
+    test('the nearest player within the hunt radius wins across many hunters', () => {
+      world.addPlayer(new Player('p1', 'Alice', 2, 10));
+      world.addPlayer(new Player('p2', 'Bob', 30, 10));
+      // x -> [target, x after one tick]; 13 is out of range (10 cells) of both
+      const expected = { 6: ['p1', 5], 12: ['p1', 11], 13: [undefined], 21: ['p2', 22], 25: ['p2', 26] };
+      const hunters = Object.keys(expected).map(x => new Mob(`h${x}`, `Hunter${x}`, Number(x), 10, true));
+      hunters.forEach(hunter => world.addMob(hunter));
+
+      world.updateMobs();
+      for (const hunter of hunters) {
+        const [target, x] = expected[hunter.id.slice(1)];
+        expect(hunter.lastTargetId).toBe(target);
+        if (target) {
+          expect(hunter.x).toBe(x);
+        }
+      }
+    });
+  });
 });
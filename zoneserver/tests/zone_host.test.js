@@ -0,0 +1,119 @@
+const net = require('net');
+const { once } = require('events');
+const ZoneHost = require('../src/zone_host');
+
+function buildJoinPacket(name) {
+  const nameBuf = Buffer.from(name);
+  return Buffer.concat([Buffer.from([0x01, nameBuf.length]), nameBuf]);
+}
+
+function readFrame(socket, timeoutMs = 2000) {
+  return new Promise((resolve, reject) => {
+    const timer = setTimeout(() => {
+      socket.off('data', onData);
+      reject(new Error(`Timed out waiting for socket data (${timeoutMs}ms)`));
+    }, timeoutMs);
+    const onData = (chunk) => {
+      clearTimeout(timer);
+      socket.off('data', onData);
+      resolve(chunk);
+    };
+    socket.on('data', onData);
+  });
+}
+
+async function connect(port) {
+  const client = net.createConnection({ port, host: '127.0.0.1' });
+  await once(client, 'connect');
+  return client;
+}
+
+describe('Zone Host', () => {
+  let host;
+  let logSpy;
+  const sockets = [];
+
+  beforeAll(async () => {
+    logSpy = jest.spyOn(console, 'log').mockImplementation(() => {});
+    host = new ZoneHost(0, { zones: 2, zone: { minMobs: 0, reconnectCapacity: 7 }, quiet: true });
+    await host.start();
+  });
+
+  afterAll(async () => {
+    for (const socket of sockets) {
+      socket.destroy();
+    }
+    await host.stop();
+    logSpy.mockRestore();
+  });
+
+  test('routes clients to separate zones, each with its own world', async () => {
+    const { port } = host.server.address();
+    const alice = await connect(port);
+    const bob = await connect(port);
+    sockets.push(alice, bob);
+
+    alice.write(buildJoinPacket('Alice'));
+    const aliceJoin = await readFrame(alice);
+    expect(aliceJoin.readUInt8(2)).toBe(0x01);
+    bob.write(buildJoinPacket('Bob'));
+    const bobJoin = await readFrame(bob);
+    expect(bobJoin.readUInt8(2)).toBe(0x01);
+
+    expect(host.zones.map(zone => zone.connections)).toEqual([1, 1]);
+
+    // 0x03 state: each zone holds only its own player
+    alice.write(Buffer.from([0x03]));
+    const aliceState = await readFrame(alice);
+    expect(aliceState.readUInt8(3)).toBe(1);
+    const msgLen = aliceState.readUInt8(6);
+    expect(String.fromCharCode(aliceState.readUInt8(7 + msgLen))).toBe('M');
+
+    bob.write(Buffer.from([0x03]));
+    const bobState = await readFrame(bob);
+    expect(bobState.readUInt8(3)).toBe(1);
+  });
+
+  test('forwards REST requests to a zone and closes sockets the zone drops', async () => {
+    const health = await host.request(0, { method: 'GET', url: '/health' });
+    expect(health.status).toBe(200);
+    expect(health.body.playerCount).toBe(1);
+    expect(health.body.reconnectCache.capacity).toBe(7);
+
+    const missing = await host.request(1, { method: 'GET', url: '/player/nobody/status' });
+    expect(missing.status).toBe(404);
+
+    // An invalid join name length makes the zone drop the connection
+    const { port } = host.server.address();
+    const client = await connect(port);
+    sockets.push(client);
+    const closed = once(client, 'close');
+    client.write(Buffer.from([0x01, 0]));
+    await closed;
+  });
+
+  test('restarts a zone whose worker dies, failing what it had in flight', async () => {
+    const dead = host.zones[1];
+    const bob = sockets[1]; // Routed to zone 1 by the first test
+    const closed = once(bob, 'close');
+
+    const terminated = dead.worker.terminate();
+    const inFlight = host.request(1, { method: 'GET', url: '/health' }).catch(err => err);
+    await terminated;
+    expect((await inFlight).message).toBe('Zone 1 exited');
+    await closed;
+
+    expect(dead.ready).toBe(false);
+    expect(host.pickZone()).toBe(host.zones[0]);
+    const refused = await host.request(1, { method: 'GET', url: '/health' }).catch(err => err);
+    expect(refused.message).toBe('Zone 1 is not running');
+
+    const deadline = Date.now() + 5000;
+    while (!host.zones[1].ready && Date.now() < deadline) {
+      await new Promise(resolve => setTimeout(resolve, 50));
+    }
+    expect(host.zones[1]).not.toBe(dead);
+    const health = await host.request(1, { method: 'GET', url: '/health' });
+    expect(health.body.playerCount).toBe(0);
+  });
+});